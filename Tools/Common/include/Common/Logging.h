@@ -0,0 +1,66 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <spdlog/common.h>
+
+namespace spdlog
+{
+    class logger;
+}
+
+namespace CLI
+{
+    class App;
+}
+
+namespace ReHitmanTools
+{
+    struct LoggingOptions
+    {
+        struct Consts
+        {
+            static const std::map<std::string, spdlog::level::level_enum> LevelsMap;
+            static constexpr size_t kDefaultQueueSize = 8192;
+        };
+
+        spdlog::level::level_enum Level     { spdlog::level::info };
+        std::string               FilePath;                              ///< Log is duplicated into this file when not empty
+        size_t                    QueueSize { Consts::kDefaultQueueSize }; ///< Max messages waiting for the writer thread
+    };
+
+    /**
+     * @brief Register --log-level and --log-file options of the tool
+     */
+    void AddLoggingOptions(CLI::App& app, LoggingOptions& options);
+
+    /**
+     * @brief Replaces default spdlog logger by async logger (console + optional file) for the lifetime of the object.
+     * @note Messages are formatted and written by single background thread. Queue is bounded: when it's full
+     *       the caller waits for free slot, so messages are never dropped.
+     */
+    class LoggingSession
+    {
+    public:
+        LoggingSession() = default;
+        LoggingSession(const LoggingSession&) = delete;
+        LoggingSession& operator=(const LoggingSession&) = delete;
+        ~LoggingSession();
+
+        /**
+         * @return false if log file could not be created (default logger is not changed in this case)
+         */
+        bool Start(const LoggingOptions& options);
+
+        /**
+         * @brief Create async logger which writes into file through the same background thread (reports etc)
+         * @return logger or nullptr if file could not be created
+         */
+        static std::shared_ptr<spdlog::logger> CreateFileLogger(const std::string& name, const std::string& path);
+
+    private:
+        bool m_isStarted { false };
+    };
+}
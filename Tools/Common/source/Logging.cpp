@@ -0,0 +1,103 @@
+#include <Common/Logging.h>
+
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <spdlog/async.h>
+#include <spdlog/async_logger.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include <CLI/App.hpp>
+
+namespace ReHitmanTools
+{
+    static constexpr size_t kLoggerThreadsCount = 1; // Single writer keeps order of messages
+
+    const std::map<std::string, spdlog::level::level_enum> LoggingOptions::Consts::LevelsMap = {
+            {"trace", spdlog::level::trace},
+            {"debug", spdlog::level::debug},
+            {"info", spdlog::level::info},
+            {"warn", spdlog::level::warn},
+            {"error", spdlog::level::err},
+            {"critical", spdlog::level::critical},
+            {"off", spdlog::level::off}
+    };
+
+    static std::shared_ptr<spdlog::details::thread_pool> GetLoggerThreadPool(size_t queueSize)
+    {
+        auto threadPool = spdlog::thread_pool();
+        if (!threadPool)
+        {
+            spdlog::init_thread_pool(queueSize, kLoggerThreadsCount);
+            threadPool = spdlog::thread_pool();
+        }
+
+        return threadPool;
+    }
+
+    void AddLoggingOptions(CLI::App& app, LoggingOptions& options)
+    {
+        app.add_option("--log-level", options.Level, "Log level: trace, debug, info (default), warn, error, critical, off")
+            ->transform(CLI::CheckedTransformer(LoggingOptions::Consts::LevelsMap, CLI::ignore_case));
+        app.add_option("--log-file", options.FilePath, "Duplicate log into file");
+    }
+
+    LoggingSession::~LoggingSession()
+    {
+        if (m_isStarted)
+        {
+            spdlog::shutdown(); // Drain queue of async loggers before exit
+        }
+    }
+
+    bool LoggingSession::Start(const LoggingOptions& options)
+    {
+        std::vector<spdlog::sink_ptr> sinks { std::make_shared<spdlog::sinks::stdout_color_sink_mt>() };
+
+        if (!options.FilePath.empty())
+        {
+            try
+            {
+                sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>(options.FilePath, true));
+            }
+            catch (const spdlog::spdlog_ex& exception)
+            {
+                spdlog::error("Logging| Failed to create log file {}: {}", options.FilePath, exception.what());
+                return false;
+            }
+        }
+
+        auto logger = std::make_shared<spdlog::async_logger>(
+                std::string {}, // Unnamed as spdlog default logger, so output format is the same
+                std::begin(sinks), std::end(sinks),
+                GetLoggerThreadPool(options.QueueSize),
+                spdlog::async_overflow_policy::block);
+
+        spdlog::set_default_logger(logger);
+        spdlog::set_level(options.Level);
+        spdlog::flush_on(spdlog::level::err);
+
+        m_isStarted = true;
+        return true;
+    }
+
+    std::shared_ptr<spdlog::logger> LoggingSession::CreateFileLogger(const std::string& name, const std::string& path)
+    {
+        try
+        {
+            auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path, true);
+            auto logger = std::make_shared<spdlog::async_logger>(
+                    name, std::move(sink),
+                    GetLoggerThreadPool(LoggingOptions::Consts::kDefaultQueueSize),
+                    spdlog::async_overflow_policy::block);
+            logger->set_level(spdlog::level::trace); // Reports are not filtered by --log-level
+            return logger;
+        }
+        catch (const spdlog::spdlog_ex& exception)
+        {
+            spdlog::error("Logging| Failed to create file {}: {}", path, exception.what());
+            return nullptr;
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ Microbenchmark of BinaryWalker read paths (virtual interface vs BasicBinaryWalker)
+ **/
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <BinaryWalker.h>
+#include <BasicBinaryWalker.h>
+
+using namespace ReGlacier;
+
+static constexpr size_t kBufferSize = 16u * 1024u * 1024u;
+static constexpr int kIterations = 16;
+
+template <typename F>
+static void Measure(const char* name, F&& routine)
+{
+    uint64_t checksum = 0;
+    const auto startTime = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < kIterations; i++)
+    {
+        checksum += routine();
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+    const auto totalReads = static_cast<double>(kIterations) * (kBufferSize / sizeof(uint32_t));
+
+    std::printf("%-40s %8.3f ns/read (checksum %llu)\n", name, elapsed / totalReads, static_cast<unsigned long long>(checksum));
+}
+
+// Keep the compiler from seeing the dynamic type of the walker
+[[gnu::noinline]] static uint64_t ReadAllVirtual(const IBaseStreamWalker& walker)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < kBufferSize / sizeof(uint32_t); i++)
+    {
+        sum += walker.ReadUInt32();
+    }
+    return sum;
+}
+
+int main()
+{
+    std::vector<uint8_t> buffer(kBufferSize);
+    for (size_t i = 0; i < buffer.size(); i++)
+    {
+        buffer[i] = static_cast<uint8_t>(i * 31u);
+    }
+
+    Measure("IBaseStreamWalker::ReadUInt32 (virtual)", [&buffer]() {
+        BinaryWalker walker { buffer.data(), buffer.size() };
+        return ReadAllVirtual(walker);
+    });
+
+    Measure("BinaryWalker::Read<uint32_t>", [&buffer]() {
+        BinaryWalker walker { buffer.data(), buffer.size() };
+        uint64_t sum = 0;
+        for (size_t i = 0; i < kBufferSize / sizeof(uint32_t); i++)
+        {
+            sum += walker.Read<uint32_t>();
+        }
+        return sum;
+    });
+
+    Measure("BinaryReader::Read<uint32_t>", [&buffer]() {
+        BinaryReader walker { buffer.data(), buffer.size() };
+        uint64_t sum = 0;
+        for (size_t i = 0; i < kBufferSize / sizeof(uint32_t); i++)
+        {
+            sum += walker.Read<uint32_t>();
+        }
+        return sum;
+    });
+
+    Measure("BasicBinaryWalker<big endian>::Read", [&buffer]() {
+        BasicBinaryWalker<const uint8_t, std::endian::big> walker { buffer.data(), buffer.size() };
+        uint64_t sum = 0;
+        for (size_t i = 0; i < kBufferSize / sizeof(uint32_t); i++)
+        {
+            sum += walker.Read<uint32_t>();
+        }
+        return sum;
+    });
+
+    return 0;
+}
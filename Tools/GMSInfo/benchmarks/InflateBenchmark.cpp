@@ -0,0 +1,130 @@
+/**
+ Microbenchmark of one shot raw inflate (zlib with init/end per call vs selected InflateBackend)
+ Usage: HBM_GMSTool_InflateBenchmark [file to compress ...] (level files like M00_main.PRM are good samples)
+ **/
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <InflateBackend.h>
+
+extern "C" {
+#include <zlib.h>
+}
+
+using namespace ReGlacier;
+
+static constexpr int kIterations = 32;
+static constexpr int kZlibRawDeflateWindowBits = -15;
+
+static std::vector<uint8_t> CompressRaw(const std::vector<uint8_t>& input)
+{
+    z_stream stream {};
+    if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, kZlibRawDeflateWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        return {};
+    }
+
+    std::vector<uint8_t> output(deflateBound(&stream, static_cast<uLong>(input.size())));
+    stream.next_in = const_cast<Bytef*>(input.data());
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = output.data();
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    const int ret = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return ret == Z_STREAM_END ? output : std::vector<uint8_t> {};
+}
+
+// Reference path: what the tool did before (fresh z_stream for each buffer)
+static bool InflateZlibReference(const std::vector<uint8_t>& input, std::vector<uint8_t>& output)
+{
+    z_stream stream {};
+    if (inflateInit2(&stream, kZlibRawDeflateWindowBits) != Z_OK)
+    {
+        return false;
+    }
+
+    stream.next_in = const_cast<Bytef*>(input.data());
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = output.data();
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    const int ret = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+
+    return ret == Z_STREAM_END;
+}
+
+template <typename F>
+static void Measure(const char* name, size_t totalBytes, F&& routine)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < kIterations; i++)
+    {
+        if (!routine())
+        {
+            std::printf("%-40s FAILED\n", name);
+            return;
+        }
+    }
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    const auto megabytes = static_cast<double>(kIterations) * static_cast<double>(totalBytes) / (1024.0 * 1024.0);
+
+    std::printf("%-40s %10.1f MiB/s\n", name, megabytes / elapsed);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::printf("Usage: %s [file to compress ...]\n", argv[0]);
+        return -1;
+    }
+
+    for (int argi = 1; argi < argc; argi++)
+    {
+        std::ifstream file { argv[argi], std::ios::binary };
+        if (!file)
+        {
+            std::printf("Unable to open file %s\n", argv[argi]);
+            continue;
+        }
+
+        const std::vector<uint8_t> original { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        const std::vector<uint8_t> compressed = CompressRaw(original);
+        if (original.empty() || compressed.empty())
+        {
+            std::printf("Unable to compress file %s\n", argv[argi]);
+            continue;
+        }
+
+        std::printf("%s: %zu -> %zu bytes\n", argv[argi], original.size(), compressed.size());
+
+        std::vector<uint8_t> output(original.size());
+
+        Measure("zlib (init/end per call)", original.size(), [&]() {
+            return InflateZlibReference(compressed, output);
+        });
+
+        Measure(InflateBackend::GetName(), original.size(), [&]() {
+            size_t writtenBytes = 0;
+            return InflateBackend::InflateRaw(compressed.data(), compressed.size(), output.data(), output.size(), writtenBytes) &&
+                   writtenBytes == original.size();
+        });
+
+        if (output != original)
+        {
+            std::printf("Output mismatch for file %s\n", argv[argi]);
+            return -1;
+        }
+    }
+
+    return 0;
+}
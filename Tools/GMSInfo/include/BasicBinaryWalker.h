@@ -0,0 +1,309 @@
+#pragma once
+
+#include <BinaryWalker.h>
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace ReGlacier
+{
+    namespace Detail
+    {
+        template <typename T> constexpr T ByteSwap(T value) requires std::is_arithmetic_v<T>
+        {
+            if constexpr (sizeof(T) == 1)
+            {
+                return value;
+            }
+            else
+            {
+                using UT = std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+                static_assert(sizeof(UT) == sizeof(T), "Unsupported arithmetic type size");
+
+                auto raw = std::bit_cast<UT>(value);
+                UT result = 0;
+                for (size_t i = 0; i < sizeof(UT); i++)
+                {
+                    result = static_cast<UT>((result << 8) | (raw & 0xFF));
+                    raw >>= 8;
+                }
+
+                return std::bit_cast<T>(result);
+            }
+        }
+    }
+
+    /**
+     * @class BasicBinaryWalker
+     * @brief Non virtual, header only version of the BinaryWalker. Every read is a bounds compare + load, so it could be inlined into parse loops.
+     * @tparam Byte uint8_t for read/write walker, const uint8_t for read only walker (write functions are not available)
+     * @tparam Endian byte order of the data in buffer (values will be swapped when it's not native)
+     */
+    template <typename Byte, std::endian Endian = std::endian::little>
+    requires (std::is_same_v<std::remove_const_t<Byte>, uint8_t>)
+    class BasicBinaryWalker
+    {
+    public:
+        using SeekType = IBaseStreamWalker::SeekType;
+
+        static constexpr SeekType BEGIN = SeekType::FROM_BEGIN;
+        static constexpr SeekType END   = SeekType::FROM_END;
+        static constexpr SeekType CURR  = SeekType::FROM_CURRENT_POSITION;
+
+        static constexpr bool kIsReadOnly = std::is_const_v<Byte>;
+        static constexpr bool kIsNativeEndian = Endian == std::endian::native;
+
+    private:
+        Byte* m_buffer { nullptr };
+        size_t m_size { 0 };
+        mutable size_t m_offset { 0 };
+
+    public:
+        constexpr BasicBinaryWalker(Byte* buffer, size_t size, size_t offset = 0)
+            : m_buffer(buffer), m_size(size), m_offset(offset)
+        {}
+
+        explicit operator bool() const { return m_buffer != nullptr && m_size > 0; }
+
+        [[nodiscard]] Byte* GetBuffer() const { return m_buffer; }
+        [[nodiscard]] size_t GetSize() const { return m_size; }
+        [[nodiscard]] size_t GetPosition() const { return m_offset; }
+
+        void Reset() { m_offset = 0; }
+
+        /**
+         * Move internal offset to passed value with passed rule (same rules as IBaseStreamWalker::Seek)
+         */
+        void Seek(size_t offset, SeekType seekType)
+        {
+            const bool isOutOfRange =
+                (seekType == SeekType::FROM_CURRENT_POSITION) ? (m_offset + offset >= m_size) : (offset >= m_size);
+
+            if (isOutOfRange)
+                throw std::out_of_range { "Seek operation failed. Current offset is greater that buffer size" };
+
+            switch (seekType)
+            {
+                case SeekType::FROM_CURRENT_POSITION: m_offset += offset; break;
+                case SeekType::FROM_BEGIN: m_offset = offset; break;
+                case SeekType::FROM_END: m_offset = m_size - offset; break;
+            }
+        }
+
+        void RequireSpace(size_t space) const
+        {
+            if (m_offset + space > m_size) [[unlikely]]
+                throw std::runtime_error { fmt::format("Not enough space! Required {} available {} (offset {:X})", space, m_size - m_offset, m_offset) };
+        }
+
+        template <typename T> T Read() const requires std::is_arithmetic_v<T>
+        {
+            T value;
+            ReadBytes(&value, sizeof(T));
+
+            if constexpr (!kIsNativeEndian)
+                return Detail::ByteSwap(value);
+            else
+                return value;
+        }
+
+        template <typename T> void Write(const T& value) requires (std::is_arithmetic_v<T> && !kIsReadOnly)
+        {
+            if constexpr (!kIsNativeEndian)
+            {
+                const T swapped = Detail::ByteSwap(value);
+                WriteBytes(&swapped, sizeof(T));
+            }
+            else
+            {
+                WriteBytes(&value, sizeof(T));
+            }
+        }
+
+        template <typename T>
+        void ReadArray(T& container) const requires (STLContainer<T>)
+        {
+            ReadArray(container.data(), container.size());
+        }
+
+        template <typename T>
+        void ReadArray(T* buffer, size_t size) const requires std::is_trivially_copyable_v<T>
+        {
+            ReadBytes(buffer, sizeof(T) * size);
+
+            if constexpr (!kIsNativeEndian && std::is_arithmetic_v<T>)
+            {
+                for (size_t i = 0; i < size; i++)
+                    buffer[i] = Detail::ByteSwap(buffer[i]);
+            }
+        }
+
+        template <typename T, size_t S>
+        void ReadArray(T* container) const
+        {
+            ReadArray<T>(container, S);
+        }
+
+        template <typename T>
+        void WriteArray(const T& container) requires (STLContainer<T> && !kIsReadOnly)
+        {
+            WriteArray(container.data(), container.size());
+        }
+
+        template <typename T>
+        void WriteArray(const T* buffer, size_t size) requires (std::is_trivially_copyable_v<T> && !kIsReadOnly)
+        {
+            if constexpr (!kIsNativeEndian && std::is_arithmetic_v<T>)
+            {
+                for (size_t i = 0; i < size; i++)
+                    Write<T>(buffer[i]);
+            }
+            else
+            {
+                WriteBytes(buffer, sizeof(T) * size);
+            }
+        }
+
+        template <typename T, size_t S>
+        void WriteArray(const T* container) requires (!kIsReadOnly)
+        {
+            WriteArray<T>(container, S);
+        }
+
+        std::string ReadZString(int limit = 1024) const
+        {
+            std::string str;
+
+            for (int it = 0; it < limit; it++)
+            {
+                const auto ch = Read<char>();
+                if (ch == 0)
+                    break;
+
+                str.push_back(ch);
+            }
+
+            return str;
+        }
+
+        /**
+         * Read zero terminated string without copy
+         * @return view into the walker's buffer (valid while the buffer is alive)
+         */
+        std::string_view ReadZStringView() const
+        {
+            RequireSpace(1);
+
+            const auto begin = reinterpret_cast<const char*>(m_buffer + m_offset);
+            const auto end = static_cast<const char*>(std::memchr(begin, 0, m_size - m_offset));
+            if (!end) [[unlikely]]
+                throw std::runtime_error { fmt::format("Unable to find end of string at {:X}", m_offset) };
+
+            const size_t length = end - begin;
+            m_offset += length + 1;
+            return { begin, length };
+        }
+
+        /**
+         * Read array of plain structs without copy
+         * @return view into the walker's buffer (valid while the buffer is alive)
+         */
+        template <typename T>
+        std::span<const T> ReadArrayView(size_t count) const requires (std::is_trivially_copyable_v<T> && kIsNativeEndian)
+        {
+            if (count > (m_size - m_offset) / sizeof(T)) [[unlikely]]
+                throw std::runtime_error { fmt::format("Not enough space for {} items of {} bytes (offset {:X})", count, sizeof(T), m_offset) };
+
+            const auto begin = m_buffer + m_offset;
+            if (reinterpret_cast<uintptr_t>(begin) % alignof(T) != 0) [[unlikely]]
+                throw std::runtime_error { fmt::format("Array at {:X} is not aligned to {} bytes", m_offset, alignof(T)) };
+
+            m_offset += count * sizeof(T);
+            return { reinterpret_cast<const T*>(begin), count };
+        }
+
+    private:
+        void ReadBytes(void* destination, size_t size) const
+        {
+            RequireSpace(size);
+
+            if (size)
+            {
+                std::memcpy(destination, m_buffer + m_offset, size);
+                m_offset += size;
+            }
+        }
+
+        void WriteBytes(const void* source, size_t size) requires (!kIsReadOnly)
+        {
+            RequireSpace(size);
+
+            if (size)
+            {
+                std::memcpy(m_buffer + m_offset, source, size);
+                m_offset += size;
+            }
+        }
+    };
+
+    using BinaryReader = BasicBinaryWalker<const uint8_t>;
+    using BinaryWriter = BasicBinaryWalker<uint8_t>;
+
+    /**
+     * @class BasicBinaryWalkerAdapter
+     * @brief IBaseStreamWalker over BasicBinaryWalker for the code which is not a template (one virtual call per read)
+     */
+    template <typename Byte, std::endian Endian = std::endian::little>
+    class BasicBinaryWalkerAdapter final : public IBaseStreamWalker
+    {
+        using Walker = BasicBinaryWalker<Byte, Endian>;
+
+        Byte* m_buffer { nullptr };
+
+    public:
+        BasicBinaryWalkerAdapter(Byte* buffer, size_t size) : IBaseStreamWalker(size, 0), m_buffer(buffer) {}
+        explicit BasicBinaryWalkerAdapter(const Walker& walker) : IBaseStreamWalker(walker.GetSize(), walker.GetPosition()), m_buffer(walker.GetBuffer()) {}
+
+        void WriteUInt8(uint8_t value) override   { Write(value); }
+        void WriteInt8(int8_t value) override     { Write(value); }
+        void WriteUInt16(uint16_t value) override { Write(value); }
+        void WriteInt16(int16_t value) override   { Write(value); }
+        void WriteUInt32(uint32_t value) override { Write(value); }
+        void WriteInt32(int32_t value) override   { Write(value); }
+
+        uint8_t ReadUInt8() const override   { return Read<uint8_t>(); }
+        int8_t ReadInt8() const override     { return Read<int8_t>(); }
+        uint16_t ReadUInt16() const override { return Read<uint16_t>(); }
+        int16_t ReadInt16() const override   { return Read<int16_t>(); }
+        uint32_t ReadUInt32() const override { return Read<uint32_t>(); }
+        int32_t ReadInt32() const override   { return Read<int32_t>(); }
+
+    private:
+        template <typename T> T Read() const
+        {
+            Walker walker { m_buffer, m_size, m_offset };
+            const T value = walker.template Read<T>();
+            m_offset = walker.GetPosition();
+            return value;
+        }
+
+        template <typename T> void Write(T value)
+        {
+            if constexpr (Walker::kIsReadOnly)
+            {
+                throw std::runtime_error { "Unable to write into read only buffer" };
+            }
+            else
+            {
+                Walker walker { m_buffer, m_size, m_offset };
+                walker.template Write<T>(value);
+                m_offset = walker.GetPosition();
+            }
+        }
+    };
+}
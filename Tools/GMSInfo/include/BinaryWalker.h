@@ -4,8 +4,11 @@
 #include <cstdint>
 
 #include <array>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
 
 #include <spdlog/spdlog.h>
@@ -71,6 +74,11 @@ namespace ReGlacier
          */
         size_t GetPosition() const;
 
+        /**
+         * @return total bytes in the stream
+         */
+        size_t GetSize() const;
+
         /**
          * @brief Function for control of buffer space requirement for ADL parsers
          * @param space how much bytes required for data structure
@@ -95,6 +103,12 @@ namespace ReGlacier
 
         virtual uint32_t ReadUInt32() const = 0;
         virtual int32_t ReadInt32() const = 0;
+
+        /**
+         * Read zero terminated string
+         * @param limit max length of the string (including terminator)
+         */
+        std::string ReadZString(int limit = 1024) const;
     };
 
     /**
@@ -105,10 +119,16 @@ namespace ReGlacier
     {
     private:
         uint8_t* m_buffer;
+        bool m_isReadOnly { false };
 
     public:
         BinaryWalker(uint8_t* buffer, size_t size);
 
+        /**
+         * @brief Create read only walker over immutable buffer (all write operations will throw std::runtime_error)
+         */
+        BinaryWalker(const uint8_t* buffer, size_t size);
+
         BinaryWalker(const BinaryWalker& copy) noexcept;
         BinaryWalker(BinaryWalker&& move) noexcept;
         BinaryWalker& operator=(const BinaryWalker& copy) noexcept;
@@ -123,70 +143,51 @@ namespace ReGlacier
          */
         template <typename T> T Read() const requires std::is_arithmetic_v<T>
         {
-            if constexpr (std::is_same_v<T, uint8_t>) return ReadUInt8();
-            else if constexpr (std::is_same_v<T, int8_t>) return ReadInt8();
-            else if constexpr (std::is_same_v<T, uint16_t>) return ReadUInt16();
-            else if constexpr (std::is_same_v<T, int16_t>) return ReadInt16();
-            else if constexpr (std::is_same_v<T, uint32_t>) return ReadUInt32();
-            else if constexpr (std::is_same_v<T, int32_t>) return ReadInt32();
-            else
-            {
-                RequireSpace(sizeof(T));
-
-                char* ptr = (&((char*)m_buffer)[m_offset]);
-
-                m_offset += sizeof(T);
-                return *((T*)ptr);
-            }
+            // Non virtual path: single bounds check + memcpy (buffer is not aligned)
+            T value;
+            ReadBytes(&value, sizeof(T));
+            return value;
         }
 
         template <typename T> void Write(const T& value) requires std::is_arithmetic_v<T>
         {
-            if constexpr (std::is_same_v<T, uint8_t>) WriteUInt8(value);
-            else if constexpr (std::is_same_v<T, int8_t>) WriteInt8(value);
-            else if constexpr (std::is_same_v<T, uint16_t>) WriteUInt16(value);
-            else if constexpr (std::is_same_v<T, int16_t>) WriteInt16(value);
-            else if constexpr (std::is_same_v<T, uint32_t>) WriteUInt32(value);
-            else if constexpr (std::is_same_v<T, int32_t>) WriteInt32(value);
-            else {
-                RequireSpace(sizeof(T));
-
-                char* ptr = (&((char*)m_buffer)[m_offset]);
-                *(T*)(ptr) = value;
-
-                m_offset += sizeof(T);
-            }
+            WriteBytes(&value, sizeof(T));
         }
 
         /**
          * Read multiple values of given type into STL container
          * @tparam T type of STL container
          * @param container reference to STL container with result
+         * @note Container of trivially copyable values will be read by single memcpy
          */
         template <typename T>
         void ReadArray(T& container) const requires (STLContainer<T>)
         {
             using IT = typename T::value_type;
 
-            if (!m_buffer || m_offset >= m_size)
-                throw std::out_of_range { fmt::format("Trying to read {:X} byte from buffer with size is {:X} bytes", m_offset, m_size) };
-
-            size_t total = container.size();
-            for (size_t i = 0; i < total; i++)
+            if constexpr (std::is_trivially_copyable_v<IT>)
+            {
+                ReadBytes(container.data(), sizeof(IT) * container.size());
+            }
+            else
             {
-                container[i] = Read<IT>();
+                for (auto& item : container)
+                {
+                    item = Read<IT>();
+                }
             }
         }
 
+        /**
+         * Read multiple values of given type into non managed container
+         * @tparam T entity type (trivially copyable only)
+         * @param buffer pointer to the storage
+         * @param size entities count
+         */
         template <typename T>
-        void ReadArray(T* buffer, size_t size) const
+        void ReadArray(T* buffer, size_t size) const requires std::is_trivially_copyable_v<T>
         {
-            if (!m_buffer || m_offset + sizeof(T) * size >= m_size)
-                throw std::out_of_range { "Unable to read buffer. Not enough bytes" };
-
-            std::memcpy(buffer, m_buffer + (sizeof(T) * size), size);
-
-            m_offset += (sizeof(T) * size);
+            ReadBytes(buffer, sizeof(T) * size);
         }
 
         /**
@@ -198,9 +199,7 @@ namespace ReGlacier
         template <typename T, size_t S>
         void ReadArray(T* container) const
         {
-            std::array<T, S> buffer;
-            ReadArray(buffer);
-            std::memcpy(container, buffer.data(), buffer.size());
+            ReadArray<T>(container, S);
         }
 
         template <typename T>
@@ -208,32 +207,38 @@ namespace ReGlacier
         {
             using IT = typename T::value_type;
 
-            for (const auto& entity : container)
+            if constexpr (std::is_trivially_copyable_v<IT>)
             {
-                Write<IT>(entity);
+                WriteBytes(container.data(), sizeof(IT) * container.size());
+            }
+            else
+            {
+                for (const auto& entity : container)
+                {
+                    Write<IT>(entity);
+                }
             }
         }
 
         template <typename T, size_t S>
         void WriteArray(const T* container)
         {
-            for (size_t i = 0; i < S; i++)
-            {
-                Write<T>(container[i]);
-            }
+            WriteArray<T>(container, S);
         }
 
         template <typename T>
-        void WriteArray(const T* buffer, size_t size)
+        void WriteArray(const T* buffer, size_t size) requires std::is_trivially_copyable_v<T>
         {
-            if (!m_buffer || m_offset + sizeof(T) * size >= m_size)
-                throw std::out_of_range { "Unable to read buffer. Not enough bytes" };
-
-            std::memcpy(m_buffer, buffer + (sizeof(T) * size), size);
-
-            m_offset += (sizeof(T) * size);
+            WriteBytes(buffer, sizeof(T) * size);
         }
 
+        /**
+         * Read zero terminated string without copy
+         * @return view into the walker's buffer (valid while the buffer is alive)
+         * @note Throws std::runtime_error when there is no terminator until end of the buffer
+         */
+        std::string_view ReadZStringView() const;
+
         // Interface
         void WriteUInt8(uint8_t value) override;
         void WriteInt8(int8_t value) override;
@@ -253,7 +258,30 @@ namespace ReGlacier
         uint32_t ReadUInt32() const override;
         int32_t ReadInt32() const override;
 
-        // Custom
-        std::string ReadZString(int limit = 1024) const;
+    private:
+        void RequireWritable() const;
+
+        void ReadBytes(void* destination, size_t size) const
+        {
+            RequireSpace(size);
+
+            if (size)
+            {
+                std::memcpy(destination, m_buffer + m_offset, size);
+                m_offset += size;
+            }
+        }
+
+        void WriteBytes(const void* source, size_t size)
+        {
+            RequireWritable();
+            RequireSpace(size);
+
+            if (size)
+            {
+                std::memcpy(m_buffer + m_offset, source, size);
+                m_offset += size;
+            }
+        }
     };
 }
\ No newline at end of file
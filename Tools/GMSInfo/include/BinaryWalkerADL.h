@@ -3,15 +3,47 @@
 #include <BinaryWalker.h>
 
 #include <string>
+#include <string_view>
 #include <array>
+#include <bit>
+#include <type_traits>
 
 namespace ReGlacier
 {
     template <typename T>
     struct BinaryWalkerADL
     {
-        static void Read(const BinaryWalker& binaryWalker, T& value) {}
-        static void Write(BinaryWalker& binaryWalker, const T& value) {}
+        template <typename TWalker>
+        static void Read(const TWalker& binaryWalker, T& value) {}
+        template <typename TWalker>
+        static void Write(TWalker& binaryWalker, const T& value) {}
+    };
+
+    /**
+     * @brief Reader/writer of the plain structs which are stored in file "as is" (packed, little endian)
+     * @tparam T struct type
+     * @tparam ExpectedSize size of the struct in file (layout guard)
+     * @note Whole struct is copied with single bounds check. Use it as base of BinaryWalkerADL specialization.
+     */
+    template <typename T, size_t ExpectedSize>
+    struct PODBinaryWalkerADL
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Struct must be trivially copyable");
+        static_assert(std::has_unique_object_representations_v<T>, "Struct must not contain padding");
+        static_assert(sizeof(T) == ExpectedSize, "Struct layout does not match the file layout");
+        static_assert(std::endian::native == std::endian::little, "Struct is stored in little endian");
+
+        template <typename TWalker>
+        static void Read(const TWalker& binaryWalker, T& value)
+        {
+            binaryWalker.template ReadArray<T>(&value, 1);
+        }
+
+        template <typename TWalker>
+        static void Write(TWalker& binaryWalker, const T& value)
+        {
+            binaryWalker.template WriteArray<T>(&value, 1);
+        }
     };
 
     template <>
@@ -19,26 +51,56 @@ namespace ReGlacier
     {
         static constexpr char kEOS = 0x0;
 
-        static void Read(const BinaryWalker& binaryWalker, std::string& value)
+        template <typename TWalker>
+        static void Read(const TWalker& binaryWalker, std::string& value)
         {
-            char ch;
-
-            while ((ch = binaryWalker.Read<char>()) != 0x0)
+            if constexpr (requires { binaryWalker.ReadZStringView(); })
             {
-                value.push_back(ch);
+                value.append(binaryWalker.ReadZStringView());
             }
+            else
+            {
+                char ch;
+
+                while ((ch = binaryWalker.template Read<char>()) != 0x0)
+                {
+                    value.push_back(ch);
+                }
+            }
+        }
+
+        template <typename TWalker>
+        static void Write(TWalker& binaryWalker, const std::string& value)
+        {
+            binaryWalker.template WriteArray<char>(value.data(), value.length());
+        }
+    };
+
+    /**
+     * @note View borrows data from the walker's buffer, so the buffer must outlive the value
+     */
+    template <>
+    struct BinaryWalkerADL<std::string_view>
+    {
+        template <typename TWalker>
+        static void Read(const TWalker& binaryWalker, std::string_view& value)
+        {
+            value = binaryWalker.ReadZStringView();
         }
 
-        static void Write(BinaryWalker& binaryWalker, const std::string& value)
+        template <typename TWalker>
+        static void Write(TWalker& binaryWalker, const std::string_view& value)
         {
-            binaryWalker.WriteArray<char>(value.data(), value.length());
+            binaryWalker.template WriteArray<char>(value.data(), value.length());
+            binaryWalker.template Write<char>(BinaryWalkerADL<std::string>::kEOS);
         }
     };
 
     template <typename T, size_t S>
     struct BinaryWalkerADL<std::array<T, S>>
     {
-        static void Read(const BinaryWalker& binaryWalker, std::array<T, S>& array)
+        template <typename TWalker>
+        static void Read(const TWalker& binaryWalker, std::array<T, S>& array)
         {
             if constexpr (std::is_trivial_v<T>)
             {
@@ -53,7 +115,8 @@ namespace ReGlacier
             }
         }
 
-        static void Write(BinaryWalker& binaryWalker, const std::array<T, S>& array)
+        template <typename TWalker>
+        static void Write(TWalker& binaryWalker, const std::array<T, S>& array)
         {
             if constexpr (std::is_trivial_v<T>)
             {
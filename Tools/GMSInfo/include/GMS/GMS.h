@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -15,13 +17,15 @@ namespace ReGlacier
 
     class GMS : public IGameEntity
     {
-        std::vector<std::string> m_excludedAnimationsList;
+        std::vector<std::string_view> m_excludedAnimationsList; ///< Views into BUF
 
         int32_t m_totalLinkRefsCount = 0;
-        std::vector<GMSLinkRef>  m_linkRefs;
+        std::span<const SGMSEntry> m_linkRefs; ///< View into GMS body or into m_linkRefsStorage
+        std::vector<SGMSEntry> m_linkRefsStorage; ///< Copy of the table when it's not aligned in the body
 
         int32_t m_weaponHandlesCount = 0;
-        std::vector<GMSWeaponHandle> m_weaponHandles;
+        std::span<const GMSWeaponHandle> m_weaponHandles; ///< View into BUF or into m_weaponHandlesStorage
+        std::vector<GMSWeaponHandle> m_weaponHandlesStorage; ///< Copy of the handles when they are not aligned in BUF
     public:
         using Ptr = std::unique_ptr<GMS>;
 
@@ -29,24 +33,55 @@ namespace ReGlacier
 
         bool Load() override;
         bool SaveUncompressed(const std::string& filePath);
-        void PrintInfo() override;
+        void PrintInfo(spdlog::logger& report) override;
+        void WriteReport(IReportWriter& writer) override;
 
-        [[nodiscard]] const std::vector<std::string>& GetExcludedAnimations() const;
-        [[nodiscard]] const std::vector<GMSLinkRef>& GetLinkReferences() const;
+        /**
+         * @note Views below point into GMS body and BUF, they are valid until ReleaseUncompressedBuffer
+         */
+        [[nodiscard]] const std::vector<std::string_view>& GetExcludedAnimations() const;
+        [[nodiscard]] std::span<const SGMSEntry> GetLinkReferences() const;
+        [[nodiscard]] std::span<const GMSWeaponHandle> GetWeaponHandles() const;
+        [[nodiscard]] const GMSGeomTable& GetGeoms() const;
 
-        [[nodiscard]] std::unique_ptr<uint8_t[]> GetUncompressedBuffer(unsigned int& uncompressedSize);
+        /**
+         * @return group name of geom (view into BUF, valid until ReleaseUncompressedBuffer) or empty view if offset is broken
+         */
+        [[nodiscard]] std::string_view GetGeomName(size_t geomIndex) const;
+
+        /**
+         * @return geom row or std::nullopt if index is out of range
+         */
+        [[nodiscard]] std::optional<GMSGeomInfo> GetGeomInfo(size_t geomIndex) const;
+
+        /**
+         * @brief Get inflated GMS body. Body is inflated only once and stays in memory until ReleaseUncompressedBuffer
+         * @return immutable buffer or nullptr if GMS could not be inflated
+         */
+        [[nodiscard]] std::shared_ptr<const uint8_t[]> GetUncompressedBuffer(unsigned int& uncompressedSize);
+
+        /**
+         * @brief Drop inflated GMS body and BUF together with everything loaded from them, GMS becomes not loaded
+         * @note Buffers stay alive while somebody else holds them. Next export inflates the body again.
+         */
+        void ReleaseUncompressedBuffer();
     private:
-        bool LoadEntities(std::unique_ptr<char[]>&& buffer, size_t bufferSize);
-        bool LoadImportTable(const char* gmsBuffer, size_t bufferSize);
-        bool LoadProperties(const char* gmsBuffer, size_t bufferSize);
-        bool LoadExcludedAnimations(char* gmsBuffer, size_t gmsBufferSize, char* bufBuffer, size_t bufBufferSize);
-        bool LoadWeaponHandles(char* gmsBuffer, size_t gmsBufferSize, char* bufBuffer, size_t bufBufferSize);
+        bool LoadEntities(std::span<const uint8_t> gmsBody, std::span<const uint8_t> bufBody);
+        bool LoadImportTable(std::span<const uint8_t> gmsBody);
+        bool LoadGeoms(std::span<const uint8_t> gmsBody);
+        bool LoadProperties(std::span<const uint8_t> gmsBody);
+        bool LoadExcludedAnimations(std::span<const uint8_t> gmsBody, std::span<const uint8_t> bufBody);
+        bool LoadWeaponHandles(std::span<const uint8_t> gmsBody, std::span<const uint8_t> bufBody);
 
-        std::unique_ptr<uint8_t[]> GetRawGMS(size_t& bufferSize);
+        std::shared_ptr<const uint8_t[]> GetRawGMS(size_t& bufferSize);
 
     private:
-        int32_t m_totalEntities;
+        std::shared_ptr<const uint8_t[]> m_rawBody; ///< Inflated GMS body (cached by GetRawGMS), loaded views point into it
+        size_t m_rawBodySize { 0 };
+
+        std::shared_ptr<const uint8_t[]> m_bufBuffer; ///< String pool of geom names, excluded animations and weapon handles
+        size_t m_bufBufferSize { 0 };
 
-        std::vector<GMSComposedInfoHolder> m_geoms;
+        GMSGeomTable m_geoms;
     };
 }
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ReGlacier
+{
+    class GMS;
+
+    /**
+     * @brief Lookup indexes over geoms of loaded GMS. Index is immutable after construction, so it could be shared between threads.
+     * Results are geom indices (GMSGeomTable rows) ordered by key, then by index. Views are valid while the index and GMS are alive.
+     */
+    class GMSGeomIndex
+    {
+    public:
+        /**
+         * @param gms loaded GMS or nullptr (empty index)
+         */
+        explicit GMSGeomIndex(const GMS* gms);
+
+        [[nodiscard]] std::span<const uint32_t> FindByType(uint32_t typeId) const;
+        [[nodiscard]] std::span<const uint32_t> FindByNamePrefix(std::string_view prefix) const;
+        [[nodiscard]] std::span<const uint32_t> FindByPRMOffset(uint32_t prmOffset) const;
+
+        /**
+         * @return distinct type ids of geoms
+         */
+        [[nodiscard]] std::vector<uint32_t> GetTypeIds() const;
+
+    private:
+        std::unordered_map<uint32_t, std::vector<uint32_t>> m_byType;
+
+        // Sorted keys + geom of each key (equal keys are adjacent, so any key range is a single span)
+        std::vector<std::string_view> m_names;
+        std::vector<uint32_t> m_byName;
+        std::vector<uint32_t> m_prmOffsets;
+        std::vector<uint32_t> m_byPRMOffset;
+    };
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include <GlacierTypeDefs.h>
 
@@ -16,24 +19,6 @@ namespace ReGlacier
         int32_t unknown;
     };
 
-    struct GMSLinkRef
-    {
-        uint32_t index = 0u;
-
-        struct {
-            uint32_t index = 0;
-            Glacier::TypeId id = Glacier::NOT_INITIALISED;
-        } typeInfo;
-
-        GMSLinkRef() = default;
-        GMSLinkRef(uint32_t _index, uint32_t _typeId, bool isDeclared)
-                : index(_index)
-        {
-            typeInfo.index = _typeId;
-            typeInfo.id = isDeclared ? static_cast<Glacier::TypeId>(_typeId) : Glacier::NOT_FOUND;
-        }
-    };
-
     struct GMSWeaponHandle
     {
         uint32_t entityId = 0;
@@ -45,6 +30,8 @@ namespace ReGlacier
                 : entityId(id), m_field4(u0), m_field8(u1) {}
     };
 
+    static_assert(sizeof(GMSWeaponHandle) == 0xC && std::is_trivially_copyable_v<GMSWeaponHandle>, "Weapon handles are viewed right in BUF");
+
     /// -------------------------------------------------
     struct SGMSUncompressedHeader
     {
@@ -92,10 +79,48 @@ namespace ReGlacier
         uint32_t Unknown3C; //+0x3C
     };
 
-    struct GMSComposedInfoHolder
+    /**
+     * @brief Geoms of GMS as structure of arrays, row index is entity id.
+     * Only columns used by queries are kept, scans like "all geoms of type X" touch a single uint32_t column.
+     */
+    struct GMSGeomTable
+    {
+        std::vector<uint32_t> TypeIds;     ///< Glacier::TypeId of each geom
+        std::vector<uint32_t> PRMOffsets;
+        std::vector<uint32_t> NameOffsets; ///< Offsets of zero terminated group names in BUF
+
+        void Reserve(size_t count)
+        {
+            TypeIds.reserve(count);
+            PRMOffsets.reserve(count);
+            NameOffsets.reserve(count);
+        }
+
+        void Clear()
+        {
+            TypeIds.clear();
+            PRMOffsets.clear();
+            NameOffsets.clear();
+        }
+
+        void Add(const SGMSBaseGeom& geom)
+        {
+            TypeIds.push_back(static_cast<uint32_t>(geom.TypeId));
+            PRMOffsets.push_back(geom.PRMOffset);
+            NameOffsets.push_back(geom.PrimitiveBufGroupNameOffset);
+        }
+
+        [[nodiscard]] size_t GetSize() const { return TypeIds.size(); }
+    };
+
+    /**
+     * @brief Row of GMSGeomTable with resolved name
+     */
+    struct GMSGeomInfo
     {
-        int id;
-        SGMSBaseGeom baseGeom;
-        std::string  groupName;
+        uint32_t Index;
+        std::string_view Name; ///< View into BUF (valid while GMS is alive)
+        uint32_t TypeId;
+        uint32_t PRMOffset;
     };
 }
\ No newline at end of file
@@ -5,9 +5,17 @@
 #include <string>
 #include <string_view>
 
+#include <ParseDiagnostics.h>
+
+namespace spdlog
+{
+    class logger;
+}
+
 namespace ReGlacier
 {
     class LevelContainer;
+    class IReportWriter;
     struct LevelAssets;
 
     class IGameEntity
@@ -17,6 +25,7 @@ namespace ReGlacier
         LevelContainer* m_container;
         LevelAssets* m_assets;
         std::string m_name;
+        ParseDiagnostics m_diagnostics {};
 
     public:
         virtual ~IGameEntity() noexcept = default;
@@ -28,8 +37,25 @@ namespace ReGlacier
         {
         }
 
+        /**
+         * @brief Set how much information parser produces on Load (nothing by default)
+         */
+        void SetParseDiagnostics(const ParseDiagnostics& diagnostics) { m_diagnostics = diagnostics; }
+
         virtual bool Load() = 0;
 
-        virtual void PrintInfo() {}
+        [[nodiscard]] bool IsLoaded() const { return m_isLoaded; }
+
+        /**
+         * @brief Write human readable report about the entity
+         * @param report logger who receives the report lines
+         */
+        virtual void PrintInfo(spdlog::logger& /*report*/) {}
+
+        /**
+         * @brief Write machine readable report about the entity (same data as PrintInfo)
+         * @param writer receiver of the report records
+         */
+        virtual void WriteReport(IReportWriter& /*writer*/) {}
     };
 }
\ No newline at end of file
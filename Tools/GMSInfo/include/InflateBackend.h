@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ReGlacier
+{
+    /**
+     * @brief One shot inflate of raw deflate streams (no zlib/gzip header) when the output size is known up front.
+     * @note Backend is selected at build time: zlib (default) or libdeflate (GMSTOOL_USE_LIBDEFLATE)
+     */
+    namespace InflateBackend
+    {
+        /**
+         * @return name of the backend which was selected at build time
+         */
+        const char* GetName();
+
+        /**
+         * @brief Inflate whole raw deflate stream into the output buffer
+         * @param input compressed data
+         * @param inputSize size of compressed data
+         * @param output destination buffer
+         * @param outputSize size of the destination buffer (expected uncompressed size)
+         * @param writtenBytes total bytes written into output
+         * @return true if stream inflated without errors
+         */
+        bool InflateRaw(const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize, size_t& writtenBytes);
+
+        /**
+         * @return CRC-32 (zip flavour) of the buffer
+         */
+        uint32_t Crc32(const uint8_t* buffer, size_t size);
+    }
+}
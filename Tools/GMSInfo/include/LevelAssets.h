@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 namespace ReGlacier
 {
@@ -25,5 +26,10 @@ namespace ReGlacier
 
         [[nodiscard]] bool AllResolved() const;
         void TryResolve(const std::string& path);
+
+        /**
+         * @return paths of all resolved assets
+         */
+        [[nodiscard]] std::vector<std::string> GetResolvedPaths() const;
     };
 }
\ No newline at end of file
@@ -1,18 +1,261 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <MappedFile.h>
 
 namespace ReGlacier
 {
+    class ThreadPool;
+
+    /**
+     * @class LevelContainer
+     * @brief Thread safe reader of files from level archive
+     * @note minizip handles are not thread safe, so each concurrent reader takes own handle of the archive from the pool
+     */
     class LevelContainer
     {
-        void* m_zip;
+    public:
+        /**
+         * @brief Location of the file inside the level archive (mirror of minizip's unz_file_pos + file info)
+         */
+        struct Entry
+        {
+            static constexpr size_t kUnresolvedDataOffset = static_cast<size_t>(-1);
+
+            unsigned long PosInZipDirectory { 0 }; ///< Offset of the entry in the central directory
+            unsigned long NumFile { 0 };           ///< Index of the entry in the central directory
+            size_t CompressedSize { 0 };
+            size_t UncompressedSize { 0 };
+            int CompressionMethod { 0 };
+            mutable std::atomic<size_t> DataOffset { kUnresolvedDataOffset }; ///< Offset of the file contents in the archive (0 - unknown), resolved on the first read
+            uint32_t Crc32 { 0 };
+        };
+
+        static constexpr int kStoredCompressionMethod = 0;
+        static constexpr int kDeflatedCompressionMethod = 8;
+
+        /**
+         * @class InflateStream
+         * @brief Pull based reader of the single file. Data is inflated only when somebody asks for it.
+         * @note Stream holds own archive handle until destruction, so don't keep it longer than needed
+         */
+        class InflateStream
+        {
+            friend class LevelContainer;
+
+            LevelContainer* m_owner { nullptr };
+            void* m_handle { nullptr };
+            std::string m_path;
+            size_t m_size { 0 };
+            size_t m_position { 0 };
+
+            InflateStream(LevelContainer* owner, void* handle, std::string path, size_t size);
+
+        public:
+            using Ptr = std::unique_ptr<InflateStream>;
+
+            ~InflateStream();
+
+            InflateStream(const InflateStream&) = delete;
+            InflateStream& operator=(const InflateStream&) = delete;
+
+            /**
+             * @brief Inflate next bytes of the file
+             * @param buffer destination
+             * @param size max bytes to read
+             * @return total read bytes (0 - end of file)
+             * @note Throws std::runtime_error when archive is corrupted
+             */
+            size_t Read(uint8_t* buffer, size_t size);
+
+            /**
+             * @return uncompressed size of the file
+             */
+            [[nodiscard]] size_t GetSize() const;
+
+            /**
+             * @return total bytes already read from the stream
+             */
+            [[nodiscard]] size_t GetPosition() const;
+
+            [[nodiscard]] const std::string& GetPath() const;
+        };
+
+        using ConstBuffer = std::shared_ptr<const uint8_t[]>;
+
+        /**
+         * @brief Result of ReadMany for the single file
+         */
+        struct ReadResult
+        {
+            ConstBuffer Buffer; ///< nullptr if file could not be read
+            size_t BufferSize { 0 };
+        };
+
+        /**
+         * @brief Visitor of ForEachEntry
+         * @note contents are valid only until visitor returns (copy them if you need them later)
+         * @return false to stop iteration
+         */
+        using EntryVisitor = std::function<bool(std::string_view path, const Entry& entry, std::span<const uint8_t> contents)>;
+
+        static constexpr size_t kDefaultCacheBudget = 256u * 1024u * 1024u; ///< 256 MiB of inflated assets
+
+    private:
+        struct CachedAsset
+        {
+            ConstBuffer Buffer;
+            size_t BufferSize { 0 };
+        };
+
+        struct CacheEntry
+        {
+            std::shared_future<CachedAsset> Asset; ///< Not ready while the asset is inflating in other thread
+            size_t BufferSize { 0 };
+            std::list<std::string>::iterator LRUPosition;
+        };
+
+        struct PathHash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view path) const { return std::hash<std::string_view>{}(path); }
+        };
+
+        class HandleLease;
+
+        std::string m_archivePath;
+        MappedFile::Ptr m_mapping { nullptr }; ///< Image of the whole archive (optional)
+
+        // Opened archive handles
+        std::vector<void*> m_handles;
+        std::vector<void*> m_freeHandles;
+        std::mutex m_handlesMutex;
+
+        // Immutable after BuildIndex
+        std::unordered_map<std::string, Entry, PathHash, std::equal_to<>> m_index; ///< Path -> entry (lookup by view without allocation)
+        std::vector<std::string> m_entryNames;
+
+        // Cache of inflated assets (most recently used at front)
+        std::unordered_map<std::string, CacheEntry> m_cache;
+        std::list<std::string> m_lru;
+        size_t m_cacheBudget { kDefaultCacheBudget };
+        size_t m_cacheUsage { 0 };
+        std::mutex m_cacheMutex;
+
     public:
         using Ptr = std::unique_ptr<LevelContainer>;
 
-        explicit LevelContainer(void* zipPtr);
+        explicit LevelContainer(std::string archivePath);
+        ~LevelContainer();
+
+        LevelContainer(const LevelContainer&) = delete;
+        LevelContainer& operator=(const LevelContainer&) = delete;
+
+        /**
+         * @brief Open the archive
+         * @return true if archive opened
+         */
+        bool Open();
+
+        /**
+         * @brief Walk over the central directory of the archive once and remember location of each file
+         * @note Must be called before any read operation and before concurrent usage of the container
+         * @return true if the whole archive was indexed
+         */
+        bool BuildIndex();
+
+        /**
+         * @return path to the level archive
+         */
+        [[nodiscard]] const std::string& GetArchivePath() const;
+
+        /**
+         * @return names of all files inside the archive in the central directory order
+         */
+        [[nodiscard]] const std::vector<std::string>& GetEntryNames() const;
 
+        /**
+         * @return pointer to the indexed entry or nullptr if the file not presented in the archive
+         */
+        [[nodiscard]] const Entry* FindEntry(std::string_view path) const;
+
+        /**
+         * @brief Get view of the stored (not compressed) file straight from the mapped archive
+         * @note View stays valid while the container is alive
+         * @return view of the file contents or empty span if file is compressed, not found or archive not mapped
+         */
+        [[nodiscard]] std::span<const uint8_t> GetStoredView(std::string_view path) const;
+
+        /**
+         * @brief Read and inflate file into the new buffer owned by caller
+         * @note Use it only when you need to modify contents of the buffer, otherwise prefer ReadShared
+         */
         std::unique_ptr<uint8_t[]> Read(std::string_view path, size_t& bufferSize);
+
+        /**
+         * @brief Read file through the cache of inflated assets.
+         * @note Each file will be inflated only once while it's in the cache (concurrent readers of the same file
+         *       will wait for the first one). Buffer stays alive while somebody holds it even if it was evicted from the cache.
+         * @note Stored files are not copied at all: result points into the mapped archive and does not use the cache budget.
+         * @return immutable shared buffer or nullptr if file could not be read
+         */
+        ConstBuffer ReadShared(std::string_view path, size_t& bufferSize);
+
+        /**
+         * @brief Read bunch of files concurrently (each file is read on the own worker with own archive handle)
+         * @note Cache is bypassed: inflated files are owned by results only, stored files point into the mapped archive
+         * @param paths files to read
+         * @param pool workers (pool without workers reads everything on the calling thread)
+         * @return results in the same order as paths
+         */
+        std::vector<ReadResult> ReadMany(std::span<const std::string> paths, ThreadPool& pool);
+
+        /**
+         * @brief Open file for incremental reading (nothing will be inflated until first read)
+         * @note Stream bypasses the cache. Prefer it for big files which are parsed forward only.
+         * @return stream or nullptr if file could not be opened
+         */
+        InflateStream::Ptr OpenStream(std::string_view path);
+
+        /**
+         * @brief Read every file of the archive in one pass and pass its contents to the visitor
+         * @note Files are visited in order of their data in the archive (not central directory order), so the archive is read
+         *       strictly forward. Single archive handle and single output buffer are used for the whole pass, the cache is bypassed.
+         * @return true if all files were read and visitor did not stop iteration
+         */
+        bool ForEachEntry(const EntryVisitor& visitor);
+
+        /**
+         * @brief Set memory budget of the cache. Least recently used assets will be evicted when budget exceeded.
+         * @param budget max total size of cached buffers in bytes (0 - disable cache)
+         */
+        void SetCacheBudget(size_t budget);
+
+        /**
+         * @brief Drop all cached buffers
+         */
+        void ClearCache();
+
+    private:
+        void* AcquireHandle();
+        void ReleaseHandle(void* handle);
+
+        void EvictCachedBuffers(size_t budget);
+        [[nodiscard]] size_t GetDataOffset(const Entry& entry) const;
+        [[nodiscard]] size_t LocateEntryData(unsigned long posInCentralDirectory) const;
+        bool InflateMappedEntry(std::string_view path, const Entry& entry, uint8_t* output);
+        bool ReadEntryWithHandle(void* handle, std::string_view path, const Entry& entry, uint8_t* output, size_t& readBytes);
     };
-}
\ No newline at end of file
+}
@@ -1,9 +1,25 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include <ParseDiagnostics.h>
+#include <GMS/GMSTypes.h>
+
+namespace spdlog
+{
+    class logger;
+}
 
 namespace ReGlacier
 {
+    class IReportWriter;
+    class GMSGeomIndex;
+
     class LevelDescription
     {
     protected:
@@ -16,12 +32,35 @@ namespace ReGlacier
 
         bool Open();
         [[nodiscard]] bool IsMain() const;
-        void LoadAndAnalyze();
-        void PrintInfo();
+        /**
+         * @brief Load all not ignored assets of the level
+         * @return true if all assets were loaded
+         */
+        bool LoadAndAnalyze();
+        void PrintInfo(spdlog::logger& report);
+        /**
+         * @brief Write machine readable report: "level" record followed by records of loaded assets
+         * @param loaded result of LoadAndAnalyze
+         */
+        void WriteReport(IReportWriter& writer, bool loaded);
         void ExportUncompressedGMS(const std::string& path);
         bool ExportLocalizationToJson(std::string_view path);
         bool GenerateGMSWithUncompressedBody(std::string_view path);
 
+        /**
+         * @brief Unpack all files of the level archive into directory (archive is read in one forward pass)
+         * @note Works right after Open(), LoadAndAnalyze() is not required
+         * @return true if all files were extracted
+         */
+        bool ExtractAllFiles(std::string_view directory);
+
+        /**
+         * @brief Unpack known level assets (GMS, PRM, BUF, ...) into directory. Assets are inflated in parallel.
+         * @note Works right after Open(), count of used threads is controlled by SetWorkersCount
+         * @return true if all assets were extracted
+         */
+        bool ExtractAssets(std::string_view directory);
+
         void SetIgnoreGMSFlag(bool flag);
         void SetIgnoreANMFlag(bool flag);
         void SetIgnoreLOCFlag(bool flag);
@@ -29,7 +68,42 @@ namespace ReGlacier
         void SetIgnorePRPFlag(bool flag);
         void SetIgnoreTEXFlag(bool flag);
         void SetIgnoreSNDFlag(bool flag);
+
+        /**
+         * @brief Set how much threads will be used to load level assets
+         * @param workersCount total workers (0 or 1 - load all assets on the calling thread)
+         */
+        void SetWorkersCount(size_t workersCount);
+
+        /**
+         * @brief Set diagnostics of asset parsers (applied on LoadAndAnalyze)
+         */
+        void SetParseDiagnostics(const ParseDiagnostics& diagnostics);
+
+        /**
+         * @brief Drop inflated buffers (GMS body and BUF, cached assets) for memory constrained runs
+         * @note GMS is unloaded: its info, report and geom queries are empty until next LoadAndAnalyze
+         */
+        void ReleaseCachedBuffers();
+
+        /**
+         * @name Geom queries
+         * Work after LoadAndAnalyze, results are empty when GMS is not loaded. Indexes are built on the first query (once, thread safe), so next queries are lookups only.
+         * Queries must not run concurrently with LoadAndAnalyze or ReleaseCachedBuffers: both of them drop the indexes.
+         * Results are geom indices (use GetGeomInfo to get the row), views are valid until the next LoadAndAnalyze or ReleaseCachedBuffers.
+         * @{
+         */
+        [[nodiscard]] std::span<const uint32_t> FindGeomsByType(uint32_t typeId) const;
+        /**
+         * @param typeName type name from types database (e.g. ZHM3Actor)
+         */
+        [[nodiscard]] std::vector<uint32_t> FindGeomsByTypeName(std::string_view typeName) const;
+        [[nodiscard]] std::span<const uint32_t> FindGeomsByNamePrefix(std::string_view prefix) const;
+        [[nodiscard]] std::span<const uint32_t> FindGeomsByPRMOffset(uint32_t prmOffset) const;
+        [[nodiscard]] std::optional<GMSGeomInfo> GetGeomInfo(uint32_t geomIndex) const;
+        /** @} */
     private:
         bool ValidateLevelArchive();
+        [[nodiscard]] const GMSGeomIndex* GetGeomIndex() const;
     };
 }
\ No newline at end of file
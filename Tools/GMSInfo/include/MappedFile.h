@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace ReGlacier
+{
+    /**
+     * @class MappedFile
+     * @brief Read only memory mapping of the whole file
+     */
+    class MappedFile
+    {
+    public:
+        using Ptr = std::shared_ptr<MappedFile>;
+
+        explicit MappedFile(std::string path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Map file into memory
+         * @return true if file mapped
+         */
+        bool Open();
+
+        [[nodiscard]] bool IsOpened() const;
+        [[nodiscard]] const uint8_t* GetData() const;
+        [[nodiscard]] size_t GetSize() const;
+
+        /**
+         * @return view of the mapped range or empty span if range is out of the file
+         */
+        [[nodiscard]] std::span<const uint8_t> GetRange(size_t offset, size_t size) const;
+
+    private:
+        void Close();
+
+    private:
+        std::string m_path;
+        const uint8_t* m_data { nullptr };
+        size_t m_size { 0 };
+#ifdef _WIN32
+        void* m_fileHandle { nullptr };
+        void* m_mappingHandle { nullptr };
+#else
+        int m_fileDescriptor { -1 };
+#endif
+    };
+}
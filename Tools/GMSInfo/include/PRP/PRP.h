@@ -1,9 +1,14 @@
 #pragma once
 
 #include <IGameEntity.h>
-#include <PRP/PRPTreeNode.h>
+#include <PRP/PRPTokenStream.h>
 
+#include <array>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ReGlacier
@@ -19,15 +24,40 @@ namespace ReGlacier
         ~PRP();
 
         bool Load() override;
-        void PrintInfo() override;
+        void PrintInfo(spdlog::logger& report) override;
+        void WriteReport(IReportWriter& writer) override;
 
     private:
-        void TryToDecompileEntities(std::unique_ptr<uint8_t[]>&& buffer, size_t bufferSize);
+        /**
+         * @brief Counters of the values section (collected only when parse diagnostics enabled)
+         */
+        struct ParseStats
+        {
+            std::array<uint32_t, 256> TagsCount {};
+            size_t TotalTags { 0 };
+            size_t MaxDepth { 0 };
+            size_t TotalBytes { 0 };
+            size_t SkippedBytes { 0 };
+        };
+
+        template <ParseDiagnosticsLevel Level, typename TWalker>
+        void TryToDecompileEntities(TWalker& binaryWalker);
+
+        template <typename TWalker>
+        uint32_t ReadKeyIndex(TWalker& binaryWalker) const;
+
+        template <typename TWalker>
+        PRPDataBlock ReadPayload(TWalker& binaryWalker, const PRP_TagInfo& info);
+
+        template <typename TWalker>
+        std::span<uint8_t> ReadInlineData(TWalker& binaryWalker);
 
     private:
         int m_keysCount { 0 };
         int m_valuesOffset { 0 };
-        std::vector<std::string> m_keys {};
-        PRPTreeNode* m_tree { nullptr };
+        std::unique_ptr<char[]> m_keysPool {}; ///< Raw keys table, owner of m_keys
+        std::vector<std::string_view> m_keys {};
+        std::unique_ptr<PRPTokenStream> m_tokens { nullptr }; ///< Tree of tags in values section
+        std::optional<ParseStats> m_parseStats {};
     };
 }
\ No newline at end of file
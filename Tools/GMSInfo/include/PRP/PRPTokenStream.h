@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <PRP/PRPTypes.h>
+
+namespace ReGlacier
+{
+    /**
+     * @brief Decoded payload of the tag. Strings and raw data are views into PRP keys table or into the token stream arena.
+     */
+    using PRPDataBlock = std::variant<std::monostate, bool, char, int8_t, int16_t, int32_t, uint32_t, float, double, std::string_view, std::span<const uint8_t>>;
+
+    /**
+     * @class PRPTokenStream
+     * @brief Flat tree of PRP tags. Tokens are stored contiguously in order of appearance and linked by indices
+     *        (parent, first child, next sibling). Payloads which are not in PRP keys table are taken from the monotonic
+     *        arena, so they are released at once with the stream.
+     */
+    class PRPTokenStream
+    {
+    public:
+        using Index = uint32_t;
+
+        static constexpr Index kNoToken = std::numeric_limits<Index>::max();
+        static constexpr uint32_t kNoName = std::numeric_limits<uint32_t>::max();
+        static constexpr Index kRootToken = 0;
+        static constexpr size_t kDefaultExpectedTokens = 4096;
+
+        struct Token
+        {
+            uint32_t Offset { 0 };               ///< Position of the tag in PRP file
+            Index Parent { kNoToken };
+            Index FirstChild { kNoToken };
+            Index NextSibling { kNoToken };
+            uint32_t NameIndex { kNoName };      ///< Index of the name in keys table (named tags only)
+            PRP_ETag Tag { PRP_ETag::NO_TAG };
+            PRPDataBlock Value {};               ///< Payload (count of elements for arrays & containers)
+        };
+
+    private:
+        struct Scope
+        {
+            Index Owner { kNoToken };
+            Index LastChild { kNoToken };
+        };
+
+        std::pmr::monotonic_buffer_resource m_arena; ///< Payloads only (grown vectors would leave old copies in it)
+        std::vector<Token> m_tokens;
+        std::vector<Scope> m_scopes;
+
+    public:
+        /**
+         * @param expectedTokens count of tokens to reserve (stream grows when it's not enough)
+         */
+        explicit PRPTokenStream(size_t expectedTokens = kDefaultExpectedTokens);
+
+        PRPTokenStream(const PRPTokenStream&) = delete;
+        PRPTokenStream& operator=(const PRPTokenStream&) = delete;
+
+        /**
+         * @brief Add token as the last child of the current scope
+         * @return index of the new token
+         */
+        Index Append(PRP_ETag tag, size_t offset, PRPDataBlock value = {}, uint32_t nameIndex = kNoName);
+
+        /**
+         * @brief Make token the current scope (next tokens will be added as its children)
+         */
+        void OpenScope(Index token);
+
+        /**
+         * @brief Return to the scope of parent token
+         * @return false if current scope is root
+         */
+        bool CloseScope();
+
+        /**
+         * @brief Take memory for payload from the arena (for data which does not live in PRP keys table)
+         * @return buffer which is valid while the stream is alive
+         */
+        std::span<uint8_t> AllocatePayload(size_t size);
+        [[nodiscard]] bool IsAtRoot() const;
+
+        /**
+         * @return total opened scopes (0 - at root)
+         */
+        [[nodiscard]] size_t GetDepth() const;
+
+        [[nodiscard]] size_t GetSize() const;
+        [[nodiscard]] const Token& Get(Index index) const;
+        [[nodiscard]] std::span<const Token> GetTokens() const;
+    };
+}
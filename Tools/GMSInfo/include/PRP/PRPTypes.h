@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <string_view>
 
@@ -43,8 +44,96 @@ namespace ReGlacier
         NO_TAG
     };
 
+    /**
+     * @brief Layout of the data after the tag byte (named tags have uint32 index of the name in keys table before the payload)
+     */
+    enum class PRP_EPayload : uint8_t
+    {
+        None,       ///< no data
+        Byte,       ///< 1 byte (char, bool, int8)
+        Int16,      ///< 2 bytes
+        Int32,      ///< 4 bytes
+        Float32,    ///< 4 bytes
+        Float64,    ///< 8 bytes
+        Count,      ///< uint32 total elements of array/container
+        Bitfield,   ///< uint32
+        String,     ///< uint32 index in keys table (or uint32 length + chars when PRP has no keys table)
+        RawData     ///< uint32 length + bytes
+    };
+
+    struct PRP_TagInfo
+    {
+        PRP_ETag Tag { PRP_ETag::NO_TAG };
+        PRP_EPayload Payload { PRP_EPayload::None };
+        int8_t DepthDelta { 0 };  ///< +1 - tag opens new level, -1 - tag closes current level
+        bool IsNamed { false };
+        std::string_view Name { "(NOT A TAG)" };
+    };
+
+    namespace Detail
+    {
+        constexpr std::array<PRP_TagInfo, 256> MakePRPTagInfoTable()
+        {
+            std::array<PRP_TagInfo, 256> table {};
+
+            // Gaps between known tags are reserved by format
+            for (size_t byte = PRP_ETag::TAG_Array; byte <= PRP_ETag::TAG_NameBitfield; byte++)
+            {
+                table[byte] = PRP_TagInfo { PRP_ETag::TAG_UNKNOWN, PRP_EPayload::None, 0, false, "PRP_ETag::TAG_UNKNOWN" };
+            }
+
+            auto add = [&table](PRP_ETag tag, PRP_EPayload payload, int8_t depthDelta, std::string_view name) {
+                const bool isNamed = (tag & 0x80) != 0;
+                table[tag] = PRP_TagInfo { tag, payload, depthDelta, isNamed, name };
+            };
+
+#define PRP_TAG(id, payload, depthDelta) add(PRP_ETag::id, PRP_EPayload::payload, depthDelta, "PRP_ETag::" #id)
+            PRP_TAG(TAG_Array,            Count,    +1);
+            PRP_TAG(TAG_BeginObject,      None,     +1);
+            PRP_TAG(TAG_Reference,        String,    0);
+            PRP_TAG(TAG_Container,        Count,    +1);
+            PRP_TAG(TAG_Char,             Byte,      0);
+            PRP_TAG(TAG_Bool,             Byte,      0);
+            PRP_TAG(TAG_Int8,             Byte,      0);
+            PRP_TAG(TAG_Int16,            Int16,     0);
+            PRP_TAG(TAG_Int32,            Int32,     0);
+            PRP_TAG(TAG_Float32,          Float32,   0);
+            PRP_TAG(TAG_Float64,          Float64,   0);
+            PRP_TAG(TAG_String,           String,    0);
+            PRP_TAG(TAG_RawData,          RawData,   0);
+            PRP_TAG(TAG_Bitfield,         Bitfield,  0);
+            PRP_TAG(TAG_EndArray,         None,     -1);
+            PRP_TAG(TAG_SkipMark,         None,      0);
+            PRP_TAG(TAG_EndObject,        None,     -1);
+            PRP_TAG(TAG_EndOfStream,      None,     -1);
+            PRP_TAG(TAG_NamedArray,       Count,    +1);
+            PRP_TAG(TAG_BeginNamedObject, None,     +1);
+            PRP_TAG(TAG_NamedReference,   String,    0);
+            PRP_TAG(TAG_NamedContainer,   Count,    +1);
+            PRP_TAG(TAG_NamedChar,        Byte,      0);
+            PRP_TAG(TAG_NamedBool,        Byte,      0);
+            PRP_TAG(TAG_NamedInt8,        Byte,      0);
+            PRP_TAG(TAG_NamedInt16,       Int16,     0);
+            PRP_TAG(TAG_NamedInt32,       Int32,     0);
+            PRP_TAG(TAG_NamedFloat32,     Float32,   0);
+            PRP_TAG(TAG_NamedFloat64,     Float64,   0);
+            PRP_TAG(TAG_NamedString,      String,    0);
+            PRP_TAG(TAG_NamedRawData,     RawData,   0);
+            PRP_TAG(TAG_NameBitfield,     Bitfield,  0);
+#undef PRP_TAG
+
+            return table;
+        }
+    }
+
+    /**
+     * @brief Description of each possible tag byte (single lookup instead of chains of comparisons)
+     */
+    inline constexpr std::array<PRP_TagInfo, 256> kPRPTagInfo = Detail::MakePRPTagInfoTable();
+
     struct PRP_ETag_Helpers
     {
+        static constexpr const PRP_TagInfo& GetInfo(uint8_t byte) { return kPRPTagInfo[byte]; }
         static PRP_ETag FromByte(uint8_t byte);
         static std::string_view ToString(PRP_ETag tag);
         static bool IsTagIncreaseDepthLevel(PRP_ETag tag);
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace spdlog
+{
+    class logger;
+}
+
+namespace ReGlacier
+{
+    enum class ParseDiagnosticsLevel : uint8_t
+    {
+        Off,        ///< Nothing is collected (default)
+        Summary,    ///< Counters of parsed data, they are printed into the report
+        Trace       ///< Summary + line per parsed element into TraceLogger
+    };
+
+    /**
+     * @brief How much information entity parser should produce (see IGameEntity::SetParseDiagnostics)
+     */
+    struct ParseDiagnostics
+    {
+        ParseDiagnosticsLevel Level { ParseDiagnosticsLevel::Off };
+        std::shared_ptr<spdlog::logger> TraceLogger { nullptr }; ///< Receiver of trace lines (default logger when not set)
+
+        /**
+         * @return level by name (off, summary, trace) or std::nullopt if name is unknown
+         */
+        static std::optional<ParseDiagnosticsLevel> LevelFromString(std::string_view name);
+
+        /**
+         * @brief Create logger which writes trace lines into file on background thread
+         * @return logger or nullptr if file could not be created
+         */
+        static std::shared_ptr<spdlog::logger> CreateTraceLogger(const std::string& path);
+    };
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Report/IReportWriter.h>
+#include <Report/BufferedFileWriter.h>
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace ReGlacier
+{
+    /**
+     * @brief Compact binary report.
+     *
+     * Layout (all integers are LEB128 varints unless noted):
+     *  header:  magic 'GRPT' (4 bytes), version (1 byte)
+     *  record:  kRecordBegin, name(type), fields..., kRecordEnd
+     *  field:   kind (1 byte, EFieldKind), name(key), value
+     *  value:   String - length + bytes, Int - zigzag varint, UInt - varint, Float - 8 bytes IEEE-754 LE, Bool - 1 byte
+     *  name:    id; when id is seen for the first time it's followed by length + bytes (ids go in order 0, 1, 2, ...)
+     */
+    class BinaryReportWriter : public IReportWriter
+    {
+    public:
+        static constexpr uint32_t kMagic = 0x54505247; // 'GRPT'
+        static constexpr uint8_t kVersion = 1;
+
+        enum EFieldKind : uint8_t
+        {
+            kRecordBegin = 0x01,
+            kRecordEnd = 0x02,
+
+            kString = 0x10,
+            kInt = 0x11,
+            kUInt = 0x12,
+            kFloat = 0x13,
+            kBool = 0x14
+        };
+
+        bool Open(const std::string& path);
+
+        void BeginRecord(std::string_view type) override;
+        void EndRecord() override;
+
+        void WriteString(std::string_view key, std::string_view value) override;
+        void WriteInt(std::string_view key, int64_t value) override;
+        void WriteUInt(std::string_view key, uint64_t value) override;
+        void WriteFloat(std::string_view key, double value) override;
+        void WriteBool(std::string_view key, bool value) override;
+
+        bool Flush() override;
+
+    private:
+        void WriteVarInt(uint64_t value);
+        void WriteName(std::string_view name);
+
+    private:
+        struct NameHash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+        };
+
+        BufferedFileWriter m_output;
+        std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> m_names; ///< Name -> id (lookup without allocation)
+    };
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ReGlacier
+{
+    /**
+     * @brief Output file with own write buffer, small writes are only copied into memory
+     */
+    class BufferedFileWriter
+    {
+    public:
+        static constexpr size_t kDefaultBufferSize = 64 * 1024;
+
+        explicit BufferedFileWriter(size_t bufferSize = kDefaultBufferSize);
+        ~BufferedFileWriter();
+
+        bool Open(const std::string& path);
+        bool Flush();
+
+        [[nodiscard]] bool IsOk() const { return m_isOk; }
+
+        void Write(const void* data, size_t size)
+        {
+            if (m_buffer.size() + size > m_bufferSize)
+            {
+                Flush();
+            }
+
+            const auto bytes = reinterpret_cast<const char*>(data);
+            m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+        }
+
+        void Write(std::string_view data) { Write(data.data(), data.size()); }
+
+        void Put(char c)
+        {
+            if (m_buffer.size() == m_bufferSize)
+            {
+                Flush();
+            }
+
+            m_buffer.push_back(c);
+        }
+
+        /**
+         * @brief Direct access to the buffer for formatters (call FlushIfFull after append)
+         */
+        std::vector<char>& GetBuffer() { return m_buffer; }
+
+        void FlushIfFull()
+        {
+            if (m_buffer.size() >= m_bufferSize)
+            {
+                Flush();
+            }
+        }
+
+    private:
+        std::ofstream m_stream;
+        std::vector<char> m_buffer;
+        size_t m_bufferSize;
+        bool m_isOk { false };
+    };
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace ReGlacier
+{
+    /**
+     * @brief Receiver of machine readable level report.
+     * Report is a flat sequence of records, each record has type ("gms.geom", "prp.key", ...) and named fields.
+     * Fields are written in one pass right after BeginRecord, nothing is kept between records.
+     */
+    class IReportWriter
+    {
+    public:
+        virtual ~IReportWriter() noexcept = default;
+
+        virtual void BeginRecord(std::string_view type) = 0;
+        virtual void EndRecord() = 0;
+
+        virtual void WriteString(std::string_view key, std::string_view value) = 0;
+        virtual void WriteInt(std::string_view key, int64_t value) = 0;
+        virtual void WriteUInt(std::string_view key, uint64_t value) = 0;
+        virtual void WriteFloat(std::string_view key, double value) = 0;
+        virtual void WriteBool(std::string_view key, bool value) = 0;
+
+        /**
+         * @brief Write buffered data to the destination
+         * @return false if any write failed since the writer was created
+         */
+        virtual bool Flush() = 0;
+    };
+}
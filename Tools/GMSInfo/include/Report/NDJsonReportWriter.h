@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Report/IReportWriter.h>
+#include <Report/BufferedFileWriter.h>
+
+#include <string>
+
+namespace ReGlacier
+{
+    /**
+     * @brief Writes each record as JSON object on the own line: {"type":"gms.geom","id":1,...}
+     * @note Strings are written byte by byte, bytes above 0x7F are treated as Latin-1 and escaped as \u00XX
+     */
+    class NDJsonReportWriter : public IReportWriter
+    {
+    public:
+        bool Open(const std::string& path);
+
+        void BeginRecord(std::string_view type) override;
+        void EndRecord() override;
+
+        void WriteString(std::string_view key, std::string_view value) override;
+        void WriteInt(std::string_view key, int64_t value) override;
+        void WriteUInt(std::string_view key, uint64_t value) override;
+        void WriteFloat(std::string_view key, double value) override;
+        void WriteBool(std::string_view key, bool value) override;
+
+        bool Flush() override;
+
+    private:
+        void WriteKey(std::string_view key);
+        void WriteQuoted(std::string_view value);
+
+    private:
+        BufferedFileWriter m_output;
+    };
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <Report/IReportWriter.h>
+
+namespace ReGlacier
+{
+    enum class ReportFormat : uint8_t
+    {
+        Text,   ///< Human readable tables (PrintInfo into logger)
+        NDJson, ///< JSON object per line
+        Binary  ///< See BinaryReportWriter
+    };
+
+    class ReportWriterFactory
+    {
+    public:
+        /**
+         * @return format by name (text, ndjson, binary) or std::nullopt if name is unknown
+         */
+        static std::optional<ReportFormat> FormatFromString(std::string_view name);
+
+        /**
+         * @return extension of report file with leading dot
+         */
+        static const char* GetFileExtension(ReportFormat format);
+
+        /**
+         * @brief Create structured report writer and open the file
+         * @return writer or nullptr if file could not be opened or format is Text
+         */
+        static std::unique_ptr<IReportWriter> Create(ReportFormat format, const std::string& path);
+    };
+}
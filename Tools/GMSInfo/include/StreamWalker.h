@@ -0,0 +1,82 @@
+#pragma once
+
+#include <BinaryWalker.h>
+#include <LevelContainer.h>
+
+#include <cstring>
+#include <vector>
+
+namespace ReGlacier
+{
+    /**
+     * @class StreamWalker
+     * @brief Read only walker over the file which is inflating right now (see LevelContainer::OpenStream)
+     * @note Only bytes inside the window are available. Seek forward is lazy (bytes will be skipped on next read),
+     *       read before the window start will throw std::out_of_range. Use it for forward only parsers.
+     */
+    class StreamWalker final : public IBaseStreamWalker
+    {
+    private:
+        LevelContainer::InflateStream::Ptr m_stream;
+        mutable std::vector<uint8_t> m_window;
+        mutable size_t m_windowBegin { 0 }; ///< Offset of the first window byte in the file
+        mutable size_t m_windowFill { 0 };  ///< Total valid bytes in the window
+
+    public:
+        static constexpr size_t kDefaultWindowSize = 64u * 1024u;
+
+        explicit StreamWalker(LevelContainer::InflateStream::Ptr&& stream, size_t windowSize = kDefaultWindowSize);
+
+        StreamWalker(const StreamWalker&) = delete;
+        StreamWalker& operator=(const StreamWalker&) = delete;
+
+        operator bool() const;
+
+        /**
+         * Read multiple values into non managed container (could be bigger than window)
+         * @tparam T entity type (trivially copyable only)
+         * @param buffer pointer to the storage
+         * @param size entities count
+         */
+        template <typename T>
+        void ReadArray(T* buffer, size_t size) const requires std::is_trivially_copyable_v<T>
+        {
+            ReadBytes(buffer, sizeof(T) * size);
+        }
+
+        // Interface
+        void WriteUInt8(uint8_t value) override;
+        void WriteInt8(int8_t value) override;
+
+        void WriteUInt16(uint16_t value) override;
+        void WriteInt16(int16_t value) override;
+
+        void WriteUInt32(uint32_t value) override;
+        void WriteInt32(int32_t value) override;
+
+        uint8_t ReadUInt8() const override;
+        int8_t ReadInt8() const override;
+
+        uint16_t ReadUInt16() const override;
+        int16_t ReadInt16() const override;
+
+        uint32_t ReadUInt32() const override;
+        int32_t ReadInt32() const override;
+
+    private:
+        /**
+         * @brief Make sure that [offset; offset + size) is in the window and move caret
+         * @return pointer to the first byte inside the window
+         */
+        const uint8_t* Consume(size_t size) const;
+
+        void ReadBytes(void* destination, size_t size) const;
+
+        template <typename T> T ReadValue() const
+        {
+            T value;
+            std::memcpy(&value, Consume(sizeof(T)), sizeof(T));
+            return value;
+        }
+    };
+}
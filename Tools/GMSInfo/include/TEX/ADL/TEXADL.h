@@ -7,72 +7,58 @@
 
 namespace ReGlacier
 {
-    template <>
-    struct BinaryWalkerADL<STEXHeader>
-    {
-        static void Read(const BinaryWalker& binaryWalker, STEXHeader& header)
-        {
-            header.Table1Location = binaryWalker.Read<uint32_t>();
-            header.Table2Location = binaryWalker.Read<uint32_t>();
-            header.RawBufferLocation = binaryWalker.Read<uint32_t>();
-            header.Unknown1 = binaryWalker.Read<uint32_t>();
-        }
-
-        static void Write(BinaryWalker& binaryWalker, const STEXHeader& header)
-        {
-            binaryWalker.Write<uint32_t>(header.Table1Location);
-            binaryWalker.Write<uint32_t>(header.Table2Location);
-            binaryWalker.Write<uint32_t>(header.RawBufferLocation);
-            binaryWalker.Write<uint32_t>(header.Unknown1);
-        }
-    };
+    template <> struct BinaryWalkerADL<STEXHeader> : PODBinaryWalkerADL<STEXHeader, 0x10> {};
 
     template <>
     struct BinaryWalkerADL<ETEXEntityType>
     {
-        static void Read(const BinaryWalker& binaryWalker, ETEXEntityType& type)
+        template <typename TWalker>
+        static void Read(const TWalker& binaryWalker, ETEXEntityType& type)
         {
             char buff[4];
-            binaryWalker.ReadArray<char, 4>(&buff[0]);
+            binaryWalker.template ReadArray<char, 4>(&buff[0]);
             type = *(ETEXEntityType*)(&buff[0]);
         }
 
-        static void Write(BinaryWalker& binaryWalker, const ETEXEntityType& entry)
+        template <typename TWalker>
+        static void Write(TWalker& binaryWalker, const ETEXEntityType& entry)
         {
-            binaryWalker.WriteArray<char, 4>((char*)&entry);
+            binaryWalker.template WriteArray<char, 4>((char*)&entry);
         }
     };
 
     template <>
     struct BinaryWalkerADL<STEXEntry>
     {
-        static void Read(const BinaryWalker& binaryWalker, STEXEntry& entry)
+        template <typename TWalker>
+        static void Read(const TWalker& binaryWalker, STEXEntry& entry)
         {
-            entry.FileSize = binaryWalker.Read<uint32_t>();
+            entry.FileSize = binaryWalker.template Read<uint32_t>();
             BinaryWalkerADL<ETEXEntityType>::Read(binaryWalker, entry.Type);
             BinaryWalkerADL<ETEXEntityType>::Read(binaryWalker, entry.Type2);
-            entry.Index = binaryWalker.Read<int32_t>();
-            entry.Height = binaryWalker.Read<int16_t>();
-            entry.Width = binaryWalker.Read<int16_t>();
-            entry.MipMapLevels = binaryWalker.Read<int32_t>();
-            entry.Unknown1 = binaryWalker.Read<int32_t>();
-            entry.Unknown2 = binaryWalker.Read<float>();
-            entry.Unknown3 = binaryWalker.Read<int32_t>();
+            entry.Index = binaryWalker.template Read<int32_t>();
+            entry.Height = binaryWalker.template Read<int16_t>();
+            entry.Width = binaryWalker.template Read<int16_t>();
+            entry.MipMapLevels = binaryWalker.template Read<int32_t>();
+            entry.Unknown1 = binaryWalker.template Read<int32_t>();
+            entry.Unknown2 = binaryWalker.template Read<float>();
+            entry.Unknown3 = binaryWalker.template Read<int32_t>();
             BinaryWalkerADL<std::string>::Read(binaryWalker, entry.FileName);
         }
 
-        static void Write(BinaryWalker& binaryWalker, const STEXEntry& entry)
+        template <typename TWalker>
+        static void Write(TWalker& binaryWalker, const STEXEntry& entry)
         {
-            binaryWalker.Write<uint32_t>(entry.FileSize);
+            binaryWalker.template Write<uint32_t>(entry.FileSize);
             BinaryWalkerADL<ETEXEntityType>::Write(binaryWalker, entry.Type);
             BinaryWalkerADL<ETEXEntityType>::Write(binaryWalker, entry.Type2);
-            binaryWalker.Write<int32_t>(entry.Index);
-            binaryWalker.Write<int16_t>(entry.Height);
-            binaryWalker.Write<int16_t>(entry.Width);
-            binaryWalker.Write<int32_t>(entry.MipMapLevels);
-            binaryWalker.Write<int32_t>(entry.Unknown1);
-            binaryWalker.Write<float>(entry.Unknown2);
-            binaryWalker.Write<int32_t>(entry.Unknown3);
+            binaryWalker.template Write<int32_t>(entry.Index);
+            binaryWalker.template Write<int16_t>(entry.Height);
+            binaryWalker.template Write<int16_t>(entry.Width);
+            binaryWalker.template Write<int32_t>(entry.MipMapLevels);
+            binaryWalker.template Write<int32_t>(entry.Unknown1);
+            binaryWalker.template Write<float>(entry.Unknown2);
+            binaryWalker.template Write<int32_t>(entry.Unknown3);
             BinaryWalkerADL<std::string>::Write(binaryWalker, entry.FileName);
         }
     };
@@ -80,19 +66,21 @@ namespace ReGlacier
     template <>
     struct BinaryWalkerADL<STEXEntityAllocationInfo>
     {
-        static void Read(const BinaryWalker& binaryWalker, STEXEntityAllocationInfo& entry)
+        template <typename TWalker>
+        static void Read(const TWalker& binaryWalker, STEXEntityAllocationInfo& entry)
         {
-            entry.MipMapLevelsSize = binaryWalker.Read<int32_t>();
+            entry.MipMapLevelsSize = binaryWalker.template Read<int32_t>();
             entry.DataOffsets = binaryWalker.GetPosition();
             entry.Data = std::make_unique<char[]>(entry.MipMapLevelsSize);
-            binaryWalker.ReadArray<char>(entry.Data.get(), entry.MipMapLevelsSize);
+            binaryWalker.template ReadArray<char>(entry.Data.get(), entry.MipMapLevelsSize);
         }
 
-        static void Write(BinaryWalker& binaryWalker, const STEXEntityAllocationInfo& entry)
+        template <typename TWalker>
+        static void Write(TWalker& binaryWalker, const STEXEntityAllocationInfo& entry)
         {
-            binaryWalker.Write<int32_t>(entry.MipMapLevelsSize);
-            binaryWalker.Write<int32_t>(entry.DataOffsets);
-            binaryWalker.WriteArray<char>(entry.Data.get(), entry.MipMapLevelsSize);
+            binaryWalker.template Write<int32_t>(entry.MipMapLevelsSize);
+            binaryWalker.template Write<int32_t>(entry.DataOffsets);
+            binaryWalker.template WriteArray<char>(entry.Data.get(), entry.MipMapLevelsSize);
         }
     };
 }
\ No newline at end of file
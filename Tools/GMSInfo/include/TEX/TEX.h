@@ -16,6 +16,7 @@ namespace ReGlacier
         TEX(std::string  name, LevelContainer* levelContainer, LevelAssets* levelAssets);
 
         bool Load() override;
+        void WriteReport(IReportWriter& writer) override;
 
         const std::vector<Texture::Ptr>& GetLoadedTextures() const;
 
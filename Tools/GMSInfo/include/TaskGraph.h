@@ -0,0 +1,61 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ReGlacier
+{
+    class ThreadPool;
+
+    /**
+     * @class TaskGraph
+     * @brief Set of tasks with dependencies between them. Task will be scheduled only when all of its dependencies are done.
+     * @note Dependencies could refer only to tasks which already added to the graph, so graph is always acyclic.
+     */
+    class TaskGraph
+    {
+    public:
+        using TaskId = size_t;
+        using Routine = std::function<void()>;
+
+        /**
+         * @brief Add task to the graph
+         * @param name task name (for logs)
+         * @param routine task body
+         * @param dependencies list of tasks who must be finished before this task
+         * @return id of new task
+         */
+        TaskId AddTask(std::string name, Routine&& routine, std::initializer_list<TaskId> dependencies = {});
+
+        /**
+         * @brief Execute all tasks on the pool and wait until all of them will be finished
+         * @note If any task threw an exception, the first one will be rethrown from this function after all tasks finished
+         */
+        void Run(ThreadPool& pool);
+
+    private:
+        struct Task
+        {
+            std::string Name;
+            Routine Body;
+            size_t PendingDependencies { 0 };
+            std::vector<TaskId> Dependents;
+        };
+
+        void Schedule(ThreadPool& pool, TaskId taskId);
+        void OnTaskFinished(ThreadPool& pool, TaskId taskId);
+
+    private:
+        std::vector<Task> m_tasks;
+
+        std::mutex m_mutex;
+        std::condition_variable m_allTasksFinished;
+        size_t m_finishedTasks { 0 };
+        std::exception_ptr m_firstException { nullptr };
+    };
+}
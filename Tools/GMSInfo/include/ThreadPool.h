@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace ReGlacier
+{
+    /**
+     * @class ThreadPool
+     * @brief Fixed size pool of worker threads with FIFO queue of tasks
+     */
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        /**
+         * @param workersCount total worker threads (0 - no workers, all tasks will be executed in Submit call)
+         */
+        explicit ThreadPool(size_t workersCount);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Put task into the queue
+         * @note Task must not throw exceptions
+         */
+        void Submit(Task&& task);
+
+        [[nodiscard]] size_t GetWorkersCount() const;
+
+        /**
+         * @return recommended workers count for current machine
+         */
+        static size_t GetDefaultWorkersCount();
+
+    private:
+        void WorkerRoutine();
+
+    private:
+        std::vector<std::thread> m_workers;
+        std::queue<Task> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_hasTasks;
+        bool m_isStopRequested { false };
+    };
+}
@@ -1,22 +1,71 @@
 #pragma once
 
-#include <array>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+
+#include <MappedFile.h>
 
 namespace ReGlacier
 {
+    /**
+     * @class TypesDataBase
+     * @brief Names of the Glacier entity types by their ids.
+     * @note Types from data/typeids.json are compiled into the tool (see GenerateGlacierTypeDefs), so the database works without
+     *       any file. Load() is needed only to add new types or override known ones without rebuild.
+     */
     class TypesDataBase
     {
+    public:
+        struct TypeInfo
+        {
+            std::string_view Name;
+            std::string_view ParentName;
+        };
+
+        static constexpr std::string_view kSnapshotExtension = ".bin";
+
     private:
-        std::unordered_map<std::string, std::array<std::string, 2>> m_db;
+        struct SnapshotRecord;
+
+        std::unordered_map<uint32_t, TypeInfo> m_db;  ///< Types loaded from JSON file (views into m_names)
+        std::unordered_set<std::string> m_names;      ///< Interned names of loaded types
+
+        // Types loaded from binary snapshot (views into m_snapshot)
+        MappedFile::Ptr m_snapshot { nullptr };
+        const SnapshotRecord* m_snapshotRecords { nullptr };
+        size_t m_snapshotRecordsCount { 0 };
+        const char* m_snapshotStrings { nullptr };
     public:
         static TypesDataBase& GetInstance();
         static void Release();
 
+        /**
+         * @brief Load additional types from JSON file (format of data/typeids.json) or from binary snapshot (*.bin, see SaveSnapshot)
+         */
         bool Load(const std::string& path);
 
+        /**
+         * @brief Save types loaded from file into binary snapshot: [header][records sorted by id][string pool]
+         * @note Snapshot is mapped into memory as is, so loading it takes no parsing at all
+         */
+        bool SaveSnapshot(const std::string& path) const;
+
+        /**
+         * @return type definition or std::nullopt if type is unknown (no allocations)
+         */
+        [[nodiscard]] std::optional<TypeInfo> FindType(uint32_t entityTypeId) const;
+
         [[nodiscard]] bool HasDefinitionForEntityTypeId(unsigned int entityTypeId) const;
         [[nodiscard]] std::string GetEntityTypeById(unsigned int entityTypeId) const;
+
+    private:
+        void Clear();
+        bool LoadJson(const std::string& path);
+        bool LoadSnapshot(const std::string& path);
+        std::string_view Intern(const std::string& name);
     };
-}
\ No newline at end of file
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 namespace ReGlacier
 {
     struct ZPackedDataChunk
@@ -8,7 +11,7 @@ namespace ReGlacier
         bool field_1; ///+1
         bool field_2; //+2
         bool field_3; //+3
-        int *m_buffer;  ///+4
+        uint8_t *m_buffer;  ///+4 (packed buffer with header, see ZPackedDecoder)
         int m_bufferSize; ///+8
         int m_uncompressedSize; ///+C
         int field_10;///+10
@@ -18,6 +21,10 @@ namespace ReGlacier
         ZPackedDataChunk();
         ~ZPackedDataChunk();
 
+        /**
+         * @brief Unpack chunk into the output buffer
+         * @return true if chunk unpacked
+         */
         bool unzip(void* outputBuffer, size_t outputBufferSize);
     };
-}
\ No newline at end of file
+}
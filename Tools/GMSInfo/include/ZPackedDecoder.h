@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace ReGlacier
+{
+    /**
+     * @class ZPackedDecoder
+     * @brief Decoder of IOI packed buffers (GMS body): [uint32 uncompressed size][uint32 compressed size][uint8 is stored flag][raw deflate data]
+     * @note Inflate is done by the InflateBackend selected at build time
+     */
+    class ZPackedDecoder
+    {
+    public:
+        struct Header
+        {
+            uint32_t UncompressedSize { 0 };
+            uint32_t CompressedSize { 0 };
+            bool IsStored { false };
+        };
+
+        static constexpr size_t kHeaderSize = 9;
+        static constexpr size_t kOutputAlignment = 16; ///< Game allocates output buffer with 16 bytes alignment
+
+        /**
+         * @brief Parse header of packed buffer
+         * @return false if buffer is too small
+         */
+        static bool ReadHeader(const uint8_t* packed, size_t packedSize, Header& header);
+
+        /**
+         * @return size of the output buffer which is required to unpack buffer with given header
+         */
+        static size_t GetUnpackedBufferSize(const Header& header);
+
+        /**
+         * @brief Unpack buffer into the memory provided by caller
+         * @param output buffer with at least GetUnpackedBufferSize(header) bytes (may be uninitialized, bytes after the unpacked data are zeroed)
+         * @return true if whole buffer unpacked
+         */
+        static bool UnpackInto(const uint8_t* packed, size_t packedSize, const Header& header, uint8_t* output, size_t outputSize);
+
+        /**
+         * @brief Inflate raw deflate stream (no zlib header)
+         * @param output buffer with at least uncompressedSize bytes
+         * @return true if exactly uncompressedSize bytes were inflated
+         */
+        static bool Inflate(const uint8_t* input, size_t inputSize, uint8_t* output, size_t uncompressedSize);
+
+        /**
+         * @brief Unpack buffer into the memory provided by allocator
+         * @param allocator callable (size_t bytes) -> owning pointer (must provide get() and operator bool)
+         * @param unpackedSize size of the result buffer (0 if failed)
+         * @return owning pointer returned by allocator or empty pointer if failed
+         */
+        template <typename TAllocator>
+        static auto Unpack(const uint8_t* packed, size_t packedSize, size_t& unpackedSize, TAllocator&& allocator) -> decltype(allocator(size_t {}))
+        {
+            unpackedSize = 0;
+
+            Header header;
+            if (!ReadHeader(packed, packedSize, header))
+            {
+                return {};
+            }
+
+            const size_t outputSize = GetUnpackedBufferSize(header);
+            auto output = allocator(outputSize);
+            if (!output || !UnpackInto(packed, packedSize, header, output.get(), outputSize))
+            {
+                return {};
+            }
+
+            unpackedSize = outputSize;
+            return output;
+        }
+
+        /**
+         * @brief Unpack buffer into the new heap buffer
+         */
+        static std::unique_ptr<uint8_t[]> Unpack(const uint8_t* packed, size_t packedSize, size_t& unpackedSize);
+    };
+}
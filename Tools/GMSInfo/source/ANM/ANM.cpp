@@ -5,7 +5,7 @@
 #include <GlacierTypeDefs.h>
 #include <TypesDataBase.h>
 
-#include <BinaryWalker.h>
+#include <BasicBinaryWalker.h>
 #include <BinaryWalkerADL.h>
 
 #include <spdlog/spdlog.h>
@@ -21,14 +21,14 @@ namespace ReGlacier
     bool ANM::Load()
     {
         size_t anmBufferSize = 0;
-        auto anmBuffer = m_container->Read(m_name, anmBufferSize);
+        auto anmBuffer = m_container->ReadShared(m_name, anmBufferSize);
 
         if (!anmBuffer)
         {
             spdlog::error("ANM::Load| Failed to load ANM file {}", m_name);
             return false;
         }
-        BinaryWalker binaryWalker(anmBuffer.get(), anmBufferSize);
+        BinaryReader binaryWalker(anmBuffer.get(), anmBufferSize);
 
         const auto gotMagicBytes = binaryWalker.Read<uint32_t>();
         const bool isValidMagicBytes = gotMagicBytes == kMagicBytes;
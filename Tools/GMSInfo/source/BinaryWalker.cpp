@@ -94,12 +94,38 @@ namespace ReGlacier
         return m_offset;
     }
 
+    size_t IBaseStreamWalker::GetSize() const
+    {
+        return m_size;
+    }
+
     void IBaseStreamWalker::RequireSpace(size_t space) const
     {
         if (m_offset + space > m_size)
             throw std::runtime_error { fmt::format("Not enough space! Required {} available {} (offset {:X})", space, m_size - m_offset, m_offset) };
     }
 
+    std::string IBaseStreamWalker::ReadZString(int limit) const
+    {
+        std::string str;
+
+        uint8_t ch = 0;
+        size_t it = 0;
+
+        do {
+            ch = ReadUInt8();
+
+            if (ch != 0)
+            {
+                str.push_back(ch);
+            }
+
+            ++it;
+        } while (ch != 0 && it < limit);
+
+        return str;
+    }
+
     // -------------------------------------------------------------------------------
 
     BinaryWalker::BinaryWalker(uint8_t* buffer, size_t size)
@@ -107,6 +133,12 @@ namespace ReGlacier
         , m_buffer(buffer)
     {}
 
+    BinaryWalker::BinaryWalker(const uint8_t* buffer, size_t size)
+        : IBaseStreamWalker(size, 0)
+        , m_buffer(const_cast<uint8_t*>(buffer)) // Writes are guarded by m_isReadOnly
+        , m_isReadOnly(true)
+    {}
+
     BinaryWalker::BinaryWalker(const BinaryWalker& copy) noexcept
         : IBaseStreamWalker(copy)
     {
@@ -125,6 +157,7 @@ namespace ReGlacier
         {
             IBaseStreamWalker::operator=(copy);
             m_buffer = copy.m_buffer;
+            m_isReadOnly = copy.m_isReadOnly;
         }
 
         return *this;
@@ -136,6 +169,7 @@ namespace ReGlacier
         {
             IBaseStreamWalker::operator=(std::move(move));
             m_buffer = move.m_buffer; move.m_buffer = nullptr;
+            m_isReadOnly = move.m_isReadOnly;
         }
 
         return *this;
@@ -145,142 +179,81 @@ namespace ReGlacier
 
     void BinaryWalker::WriteUInt8(uint8_t value)
     {
-        RequireSpace(sizeof(uint8_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-        *(uint8_t*)(ptr) = value;
-
-        m_offset += sizeof(uint8_t);
+        Write<uint8_t>(value);
     }
 
     void BinaryWalker::WriteInt8(int8_t value)
     {
-        RequireSpace(sizeof(int8_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-        *(int8_t*)(ptr) = value;
-
-        m_offset += sizeof(int8_t);
+        Write<int8_t>(value);
     }
 
     void BinaryWalker::WriteUInt16(uint16_t value)
     {
-        RequireSpace(sizeof(uint16_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-        *(uint16_t*)(ptr) = value;
-
-        m_offset += sizeof(uint16_t);
+        Write<uint16_t>(value);
     }
 
     void BinaryWalker::WriteInt16(int16_t value)
     {
-        RequireSpace(sizeof(int16_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-        *(int16_t*)(ptr) = value;
-
-        m_offset += sizeof(int16_t);
+        Write<int16_t>(value);
     }
 
     void BinaryWalker::WriteUInt32(uint32_t value)
     {
-        RequireSpace(sizeof(uint32_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-        *(uint32_t*)(ptr) = value;
-
-        m_offset += sizeof(uint32_t);
+        Write<uint32_t>(value);
     }
 
     void BinaryWalker::WriteInt32(int32_t value)
     {
-        RequireSpace(sizeof(int32_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-        *(int32_t*)(ptr) = value;
-
-        m_offset += sizeof(int32_t);
+        Write<int32_t>(value);
     }
 
     uint8_t BinaryWalker::ReadUInt8() const
     {
-        RequireSpace(sizeof(uint8_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-
-        m_offset += sizeof(uint8_t);
-        return *((uint8_t*)ptr);
+        return Read<uint8_t>();
     }
 
     int8_t BinaryWalker::ReadInt8() const
     {
-        RequireSpace(sizeof(int8_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-
-        m_offset += sizeof(int8_t);
-        return *((int8_t*)ptr);
+        return Read<int8_t>();
     }
 
     uint16_t BinaryWalker::ReadUInt16() const
     {
-        RequireSpace(sizeof(uint16_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-
-        m_offset += sizeof(uint16_t);
-        return *((uint16_t*)ptr);
+        return Read<uint16_t>();
     }
 
     int16_t BinaryWalker::ReadInt16() const
     {
-        RequireSpace(sizeof(int16_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-
-        m_offset += sizeof(int16_t);
-        return *((int16_t*)ptr);
+        return Read<int16_t>();
     }
 
     uint32_t BinaryWalker::ReadUInt32() const
     {
-        RequireSpace(sizeof(uint32_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-
-        m_offset += sizeof(uint32_t);
-        return *((uint32_t*)ptr);
+        return Read<uint32_t>();
     }
 
     int32_t BinaryWalker::ReadInt32() const
     {
-        RequireSpace(sizeof(int32_t));
-
-        char* ptr = (&((char*)m_buffer)[m_offset]);
-
-        m_offset += sizeof(int32_t);
-        return *((int32_t*)ptr);
+        return Read<int32_t>();
     }
 
-    std::string BinaryWalker::ReadZString(int limit) const
+    std::string_view BinaryWalker::ReadZStringView() const
     {
-        std::string str;
-
-        uint8_t ch = 0;
-        size_t it = 0;
+        RequireSpace(1);
 
-        do {
-            ch = ReadUInt8();
-
-            if (ch != 0)
-            {
-                str.push_back(ch);
-            }
+        const auto begin = reinterpret_cast<const char*>(m_buffer + m_offset);
+        const auto end = static_cast<const char*>(std::memchr(begin, 0, m_size - m_offset));
+        if (!end)
+            throw std::runtime_error { fmt::format("Unable to find end of string at {:X}", m_offset) };
 
-            ++it;
-        } while (ch != 0 && it < limit);
+        const size_t length = end - begin;
+        m_offset += length + 1;
+        return { begin, length };
+    }
 
-        return str;
+    void BinaryWalker::RequireWritable() const
+    {
+        if (m_isReadOnly)
+            throw std::runtime_error { "Unable to write into read only buffer" };
     }
-}
\ No newline at end of file
+}
@@ -7,79 +7,46 @@
 #include <TypesDataBase.h>
 #include <LevelAssets.h>
 
-#include <BinaryWalker.h>
+#include <BasicBinaryWalker.h>
 #include <BinaryWalkerADL.h>
+#include <ZPackedDecoder.h>
+
+#include <Report/IReportWriter.h>
 
 #include <spdlog/spdlog.h>
 
+#include <cstring>
 #include <utility>
 #include <fstream>
 #include <numeric>
 #include <set>
 
-extern "C" {
-#include <zlib.h>
-}
-
-namespace Legacy
+namespace ReGlacier
 {
-    struct GMS2
-    {
-        int field_0;
-        int m_raw;
-        int field_8;
-        int field_C;
-        int field_10;
-        int field_14;
+    enum GMSOffsets : unsigned int {
+        ExcludedAnimationsRegionAddr = 0x11,
+        WeaponHandlesRegionAddr = 0x10
     };
 
-    struct GMSFileEntry
+    /**
+     * @brief View array right in the buffer when it's aligned, otherwise copy it into storage
+     * @note Stored entries are mapped views of the archive, so data could start at any address
+     */
+    template <typename T>
+    static std::span<const T> ReadArrayViewOrCopy(const BinaryReader& binaryWalker, size_t count, std::vector<T>& storage)
     {
-        int field_0;
-        int field_4;
-        int field_8;
-    };
-
-    [[deprecated("This function is an old implementation of IOI decoder. Please, rewrite it to nice C++ api")]]
-    bool GMS_Decompress(GMS2* gms, uint8_t* gmsDecompressed, int gmsInLength) {
-        if (gms->field_14 == 1) {
-            const int length = (gms->field_C >= gmsInLength) ? gms->field_C : gmsInLength;
-            memcpy(gmsDecompressed, (void*) (gms->m_raw + 9), length);
-            return true;
-        }
-
-        auto entry = reinterpret_cast<GMSFileEntry*>(gms->m_raw);
-
-        z_stream stream;
-        stream.avail_in = gms->field_8;
-        stream.next_in = (unsigned char*) &entry->field_8 + 1;
-        stream.next_out = (Bytef*) gmsDecompressed;
-        stream.avail_out = gmsInLength;
-        stream.zalloc = Z_NULL;
-        stream.zfree = Z_NULL;
-
-        if (inflateInit2(&stream, -15) != Z_OK) {
-            spdlog::error("inflateInit2() failed!");
-            return false;
-        }
-
-        int result = inflate(&stream, Z_FINISH);
-        inflateEnd(&stream);
-
-        if ((result != Z_STREAM_END || result != Z_BUF_ERROR) && !stream.avail_out) {
-            return false;
+        const auto begin = binaryWalker.GetBuffer() + binaryWalker.GetPosition();
+        if (reinterpret_cast<uintptr_t>(begin) % alignof(T) == 0)
+        {
+            storage.clear();
+            return binaryWalker.ReadArrayView<T>(count);
         }
 
-        return true;
+        binaryWalker.RequireSpace(count * sizeof(T)); // before allocation
+        storage.resize(count);
+        binaryWalker.ReadArray(storage.data(), count);
+        return storage;
     }
-}
-
-namespace ReGlacier
-{
-    enum GMSOffsets : unsigned int {
-        ExcludedAnimationsRegionAddr = 0x11,
-        WeaponHandlesRegionAddr = 0x10
-    };
 
     GMS::GMS(std::string name, LevelContainer* levelContainer, LevelAssets* levelAssets)
         : IGameEntity(name, levelContainer, levelAssets) {}
@@ -97,53 +64,22 @@ namespace ReGlacier
             return false;
         }
 
-        size_t prmBufferSize = 0;
-        auto prmBuffer = m_container->Read(m_assets->PRM, prmBufferSize);
-        if (!prmBuffer)
-        {
-            spdlog::error("GMS::Load| Failed to load PRM {}", m_assets->PRM);
-            return false;
-        }
-
         size_t bufBufferSize = 0;
-        auto bufBuffer = m_container->Read(m_assets->BUF, bufBufferSize);
+        auto bufBuffer = m_container->ReadShared(m_assets->BUF, bufBufferSize);
         if (!bufBuffer)
         {
             spdlog::error("GMS::Load| Failed to load BUF {}", m_assets->BUF);
             return false;
         }
 
-        BinaryWalker gmsBinaryWalker(gmsBuffer.get(), gmsBufferSize);
-        BinaryWalker prmBinaryWalker(prmBuffer.get(), prmBufferSize);
-        BinaryWalker bufBinaryWalker(bufBuffer.get(), bufBufferSize);
-
-        SGMSUncompressedHeader header {};
-        BinaryWalkerADL<SGMSUncompressedHeader>::Read(gmsBinaryWalker, header);
-
-        spdlog::info("TotalEntitiesCountPos: {:X}", header.TotalEntitiesCountPos);
-
-        gmsBinaryWalker.Seek(header.TotalEntitiesCountPos, BinaryWalker::SeekType::FROM_BEGIN);
-        m_totalEntities = gmsBinaryWalker.Read<int32_t>();
-
-        spdlog::info("At TECP: +{:X}", gmsBinaryWalker.GetPosition());
-
-        m_geoms.reserve(m_totalEntities);
+        // Loaded data are views into GMS body (kept by GetRawGMS) and BUF, so BUF must live as long as they are loaded
+        m_bufBuffer = bufBuffer;
+        m_bufBufferSize = bufBufferSize;
 
-        for (int entryId = 0; entryId < m_totalEntities; ++entryId)
+        if (!LoadEntities({ gmsBuffer.get(), gmsBufferSize }, { bufBuffer.get(), bufBufferSize }))
         {
-            gmsBinaryWalker.Seek(header.TotalEntitiesCountPos + (8 * entryId), BinaryWalker::SeekType::FROM_BEGIN);
-            SGMSEntry entry {};
-            BinaryWalkerADL<SGMSEntry>::Read(gmsBinaryWalker, entry);
-
-            gmsBinaryWalker.Seek(4 * (entry.TypeInfoPos & 0xFFFFFF), BinaryWalker::SeekType::FROM_BEGIN); //& 0xFFFFFF IT'S VERY IMPORTANT!!!
-
-            auto& info = m_geoms.emplace_back();
-            info.id = entryId;
-
-            BinaryWalkerADL<SGMSBaseGeom>::Read(gmsBinaryWalker, info.baseGeom);
-
-            bufBinaryWalker.Seek(info.baseGeom.PrimitiveBufGroupNameOffset, BinaryWalker::BEGIN);
-            BinaryWalkerADL<std::string>::Read(bufBinaryWalker, info.groupName);
+            spdlog::error("GMS::Load| Failed to load entities of GMS {}", m_name);
+            return false;
         }
 
         m_isLoaded = true;
@@ -176,252 +112,345 @@ namespace ReGlacier
         return true;
     }
 
-    void GMS::PrintInfo() {
+    void GMS::PrintInfo(spdlog::logger& report) {
         {
             if (!m_excludedAnimationsList.empty())
             {
-                spdlog::info("GMS| Excluded animations");
+                report.info("GMS| Excluded animations");
                 for (const auto& anim : m_excludedAnimationsList)
                 {
-                    spdlog::info(" * {}", anim);
+                    report.info(" * {}", anim);
                 }
             }
             else
             {
-                spdlog::info("GMS| No excluded animations");
+                report.info("GMS| No excluded animations");
             }
         }
 
         {
             if (!m_weaponHandles.empty())
             {
-                spdlog::info("Weapon handles (total {}):", m_weaponHandlesCount);
-                spdlog::info("------------------------------");
+                report.info("Weapon handles (total {}):", m_weaponHandlesCount);
+                report.info("------------------------------");
 
-                spdlog::info("#     | ID     | Unknown1 | Unknown 2");
+                report.info("#     | ID     | Unknown1 | Unknown 2");
                 for (int i = 0; i < m_weaponHandles.size(); i++)
                 {
-                    spdlog::info("{:04d}    {:04X}     {:08X}   {:08X}", i, m_weaponHandles[i].entityId, m_weaponHandles[i].m_field4, m_weaponHandles[i].m_field8);
+                    report.info("{:04d}    {:04X}     {:08X}   {:08X}", i, m_weaponHandles[i].entityId, m_weaponHandles[i].m_field4, m_weaponHandles[i].m_field8);
                 }
             }
             else
             {
-                spdlog::info("GMS::LoadWeaponHandles| No weapon handles declared there. Probably, you work with LoaderSequence.GMS");
+                report.info("GMS::LoadWeaponHandles| No weapon handles declared there. Probably, you work with LoaderSequence.GMS");
             }
         }
 
         {
-            spdlog::info("GMS Geoms: ");
-            spdlog::info("    ID   |            Entity Name            |        Type Name        |    Type ID    ");
-            for (const auto& geom : m_geoms)
+            report.info("GMS Geoms: ");
+            report.info("    ID   |            Entity Name            |        Type Name        |    Type ID    ");
+            for (size_t i = 0; i < m_geoms.GetSize(); i++)
             {
-                spdlog::info("{:08X} {:33} {:23} {:8X}", geom.id, geom.groupName, Glacier::GetTypeIdAsString(geom.baseGeom.TypeId), geom.baseGeom.TypeId);
+                const auto typeId = m_geoms.TypeIds[i];
+                report.info("{:08X} {:33} {:23} {:8X}", i, GetGeomName(i), Glacier::GetTypeIdAsString(static_cast<Glacier::TypeId>(typeId)), typeId);
             }
         }
     }
 
-    const std::vector<std::string> & GMS::GetExcludedAnimations() const
+    void GMS::WriteReport(IReportWriter& writer)
+    {
+        writer.BeginRecord("gms");
+        writer.WriteUInt("excluded_animations", m_excludedAnimationsList.size());
+        writer.WriteInt("weapon_handles", m_weaponHandlesCount);
+        writer.WriteInt("link_refs", m_totalLinkRefsCount);
+        writer.WriteUInt("geoms", m_geoms.GetSize());
+        writer.EndRecord();
+
+        for (const auto& anim : m_excludedAnimationsList)
+        {
+            writer.BeginRecord("gms.excluded_animation");
+            writer.WriteString("name", anim);
+            writer.EndRecord();
+        }
+
+        for (size_t i = 0; i < m_weaponHandles.size(); i++)
+        {
+            writer.BeginRecord("gms.weapon_handle");
+            writer.WriteUInt("index", i);
+            writer.WriteUInt("entity_id", m_weaponHandles[i].entityId);
+            writer.WriteUInt("field4", m_weaponHandles[i].m_field4);
+            writer.WriteUInt("field8", m_weaponHandles[i].m_field8);
+            writer.EndRecord();
+        }
+
+        for (size_t i = 0; i < m_geoms.GetSize(); i++)
+        {
+            const auto typeId = m_geoms.TypeIds[i];
+
+            writer.BeginRecord("gms.geom");
+            writer.WriteUInt("id", i);
+            writer.WriteString("name", GetGeomName(i));
+            writer.WriteUInt("type_id", typeId);
+            writer.WriteString("type_name", Glacier::GetTypeIdAsString(static_cast<Glacier::TypeId>(typeId)));
+            writer.WriteUInt("prm_offset", m_geoms.PRMOffsets[i]);
+            writer.EndRecord();
+        }
+    }
+
+    const std::vector<std::string_view>& GMS::GetExcludedAnimations() const
     {
         return m_excludedAnimationsList;
     }
 
-    const std::vector<GMSLinkRef>& GMS::GetLinkReferences() const
+    std::span<const SGMSEntry> GMS::GetLinkReferences() const
     {
         return m_linkRefs;
     }
 
-    std::unique_ptr<uint8_t[]> GMS::GetUncompressedBuffer(unsigned int& uncompressedSize)
+    std::span<const GMSWeaponHandle> GMS::GetWeaponHandles() const
     {
-        return GetRawGMS(uncompressedSize);
+        return m_weaponHandles;
     }
 
-    bool GMS::LoadEntities(std::unique_ptr<char[]>&& gmsBuffer, size_t bufferSize)
+    const GMSGeomTable& GMS::GetGeoms() const
     {
-        std::unique_ptr<char[]> data = std::move(gmsBuffer);
-        char* buffer = data.get();
+        return m_geoms;
+    }
+
+    std::string_view GMS::GetGeomName(size_t geomIndex) const
+    {
+        if (geomIndex >= m_geoms.GetSize() || !m_bufBuffer)
+        {
+            return {};
+        }
 
-        size_t prmSize = 0, bufSize = 0;
+        const size_t offset = m_geoms.NameOffsets[geomIndex];
+        if (offset >= m_bufBufferSize)
+        {
+            return {};
+        }
 
-        auto prm = m_container->Read(m_assets->PRM, prmSize);
-        auto buf = m_container->Read(m_assets->BUF, bufSize);
+        const auto begin = reinterpret_cast<const char*>(m_bufBuffer.get() + offset);
+        const auto end = static_cast<const char*>(std::memchr(begin, 0, m_bufBufferSize - offset));
+        return end ? std::string_view { begin, static_cast<size_t>(end - begin) } : std::string_view {};
+    }
 
-        if (!prm)
+    std::optional<GMSGeomInfo> GMS::GetGeomInfo(size_t geomIndex) const
+    {
+        if (geomIndex >= m_geoms.GetSize())
         {
-            spdlog::error("GMS::LoadEntities() Failed to read PRM file {}", m_assets->PRM);
-            return false;
+            return std::nullopt;
         }
 
-        if (!buf)
+        return GMSGeomInfo {
+            static_cast<uint32_t>(geomIndex),
+            GetGeomName(geomIndex),
+            m_geoms.TypeIds[geomIndex],
+            m_geoms.PRMOffsets[geomIndex]
+        };
+    }
+
+    std::shared_ptr<const uint8_t[]> GMS::GetUncompressedBuffer(unsigned int& uncompressedSize)
+    {
+        size_t bufferSize = 0;
+        auto buffer = GetRawGMS(bufferSize);
+        uncompressedSize = static_cast<unsigned int>(bufferSize);
+        return buffer;
+    }
+
+    bool GMS::LoadEntities(std::span<const uint8_t> gmsBody, std::span<const uint8_t> bufBody)
+    {
+        // Entities are required, other sections are optional (LoaderSequence.GMS has no weapon handles etc)
+        try
+        {
+            if (!LoadImportTable(gmsBody) || !LoadGeoms(gmsBody))
+            {
+                return false;
+            }
+        }
+        catch (const std::exception& exception)
         {
-            spdlog::error("GMS::LoadEntities() Failed to read BUF file {}", m_assets->BUF);
+            spdlog::error("GMS::LoadEntities| Entities of GMS {} are broken: {}", m_name, exception.what());
             return false;
         }
 
-        auto BUFBuffer = reinterpret_cast<char*>(buf.get());
+        const auto runOptionalPass = [this](const char* passName, auto&& pass) -> bool {
+            try
+            {
+                return pass();
+            }
+            catch (const std::exception& exception)
+            {
+                spdlog::warn("GMS::LoadEntities| {} of GMS {} is broken: {}", passName, m_name, exception.what());
+                return false;
+            }
+        };
 
-        const bool importTablesOk = LoadImportTable(buffer, bufferSize);
-        const bool propertiesOk = LoadProperties(buffer, bufferSize);
-        const bool excludedAnimsOk = LoadExcludedAnimations(buffer, bufferSize, BUFBuffer, bufSize);
-        const bool weaponsHandlesOk = LoadWeaponHandles(buffer, bufferSize, BUFBuffer, bufSize);
+        const bool propertiesOk = runOptionalPass("Properties", [&]() { return LoadProperties(gmsBody); });
+        const bool excludedAnimsOk = runOptionalPass("Excluded animations", [&]() { return LoadExcludedAnimations(gmsBody, bufBody); });
+        const bool weaponsHandlesOk = runOptionalPass("Weapon handles", [&]() { return LoadWeaponHandles(gmsBody, bufBody); });
 
-        spdlog::info("GMS::LoadEntities() = {} {} {} {}", importTablesOk, propertiesOk, excludedAnimsOk, weaponsHandlesOk);
+        spdlog::debug("GMS::LoadEntities| {}: properties {}, excluded animations {}, weapon handles {}", m_name, propertiesOk, excludedAnimsOk, weaponsHandlesOk);
 
-        return importTablesOk || propertiesOk || excludedAnimsOk || weaponsHandlesOk;
+        return true;
     }
 
-    bool GMS::LoadImportTable(const char* buffer, size_t bufferSize)
+    bool GMS::LoadImportTable(std::span<const uint8_t> gmsBody)
     {
-        if (*(int*)buffer > bufferSize) {
+        BinaryReader gmsBinaryWalker(gmsBody.data(), gmsBody.size());
+
+        SGMSUncompressedHeader header {};
+        BinaryWalkerADL<SGMSUncompressedHeader>::Read(gmsBinaryWalker, header);
+
+        spdlog::debug("GMS::LoadImportTable| TotalEntitiesCountPos: {:X}", header.TotalEntitiesCountPos);
+
+        gmsBinaryWalker.Seek(header.TotalEntitiesCountPos, BinaryReader::BEGIN);
+        m_totalLinkRefsCount = gmsBinaryWalker.Read<int32_t>();
+
+        if (m_totalLinkRefsCount < 0)
+        {
+            spdlog::error("GMS::LoadImportTable| Bad entities count {} in GMS {}", m_totalLinkRefsCount, m_name);
             return false;
         }
 
-        m_totalLinkRefsCount = *(int*)&buffer[*(int*)buffer];
+        // Entry #i is located at TotalEntitiesCountPos + 8 * i (first one overlaps the counter)
+        gmsBinaryWalker.Seek(header.TotalEntitiesCountPos, BinaryReader::BEGIN);
+        m_linkRefs = ReadArrayViewOrCopy(gmsBinaryWalker, m_totalLinkRefsCount, m_linkRefsStorage);
 
-        int entityLocator = 0;
-        uint32_t entityIndex = 0;
+        return true;
+    }
 
-        auto& db = TypesDataBase::GetInstance();
+    bool GMS::LoadGeoms(std::span<const uint8_t> gmsBody)
+    {
+        BinaryReader gmsBinaryWalker(gmsBody.data(), gmsBody.size());
 
-        m_linkRefs.reserve(m_totalLinkRefsCount);
+        m_geoms.Clear();
+        m_geoms.Reserve(m_linkRefs.size());
 
-        //while (true)
-        do
+        for (const auto& entry : m_linkRefs)
         {
-            //TODO: Think how to wrap that into the structure
-            entityLocator = *(int*)(&buffer[8 * entityIndex + 4] + *(int*)buffer) & 0xFFFFFF;
-            unsigned int entityType = *(int*)(&buffer[4 * entityLocator + 20]);
-            //const bool isLoaderContents = entityType == Glacier::TypeId::ZLoader_Sequence_Setup_ZSTDOBJ;
-
-            //int ptr = (int)&buffer[4 * entityLocator];
-            m_linkRefs.emplace_back(entityIndex, entityType, db.HasDefinitionForEntityTypeId(entityType));
-
-            ++entityIndex;
-        } while (entityIndex != m_totalLinkRefsCount);
+            gmsBinaryWalker.Seek(4 * (entry.TypeInfoPos & 0xFFFFFF), BinaryReader::BEGIN); //& 0xFFFFFF IT'S VERY IMPORTANT!!!
 
-        //result = &prmBuffer[*((int*)v7 + 3)];
+            SGMSBaseGeom baseGeom {};
+            BinaryWalkerADL<SGMSBaseGeom>::Read(gmsBinaryWalker, baseGeom);
+            m_geoms.Add(baseGeom);
+        }
 
         return true;
     }
 
-    bool GMS::LoadProperties(const char* buffer, size_t bufferSize)
+    bool GMS::LoadProperties(std::span<const uint8_t> gmsBody)
     {
         return true;
     }
 
-    std::vector<std::string_view> ParseIOISmartString(const char* string, int awaitEntitiesCount)
+    bool GMS::LoadExcludedAnimations(std::span<const uint8_t> gmsBody, std::span<const uint8_t> bufBody)
     {
-        if (!string || !awaitEntitiesCount)
-            return {};
-
-        std::vector<std::string_view> result;
-        // First string not declared
-        auto caretPointer = string;
-        do {
-            int lengthOfString = static_cast<int>(caretPointer[0]); // NOLINT(cert-str34-c)
-            ++caretPointer;
-
-            result.emplace_back(caretPointer, lengthOfString);
-            caretPointer += lengthOfString;
-            --awaitEntitiesCount;
-        } while (awaitEntitiesCount);
+        m_excludedAnimationsList.clear();
 
-        return result;
-    }
+        BinaryReader gmsBinaryWalker(gmsBody.data(), gmsBody.size());
+        gmsBinaryWalker.Seek(GMSOffsets::ExcludedAnimationsRegionAddr * sizeof(uint32_t), BinaryReader::BEGIN);
+        const auto excludedAnimationsOffset = gmsBinaryWalker.Read<uint32_t>();
 
-    bool GMS::LoadExcludedAnimations(char* gmsBuffer, size_t gmsBufferSize, char* bufBuffer, size_t bufBufferSize)
-    {
-        auto excludedAnimationsOffset = ((int*)gmsBuffer)[GMSOffsets::ExcludedAnimationsRegionAddr];
-        if (excludedAnimationsOffset >= bufBufferSize)
+        if (excludedAnimationsOffset >= bufBody.size())
         {
             return false;
         }
 
-        auto totalExcludedAnimations  = ((int*)bufBuffer)[excludedAnimationsOffset / sizeof(int)];
-        if (excludedAnimationsOffset + 4 >= bufBufferSize)
+        BinaryReader bufBinaryWalker(bufBody.data(), bufBody.size(), excludedAnimationsOffset);
+        const auto totalExcludedAnimations = bufBinaryWalker.Read<int32_t>();
+        if (totalExcludedAnimations < 0)
         {
             return false;
         }
 
-        auto excludedAnimationsBuffer = (char*)&((char*)bufBuffer)[excludedAnimationsOffset + 4];
-        auto parsedAnimationsList = ParseIOISmartString(excludedAnimationsBuffer, totalExcludedAnimations);
-
-        parsedAnimationsList.reserve(parsedAnimationsList.size());
-
-        for (auto&& animName : parsedAnimationsList)
+        // IOI smart strings: 1 byte length + chars (no terminator)
+        m_excludedAnimationsList.reserve(totalExcludedAnimations);
+        for (int32_t i = 0; i < totalExcludedAnimations; i++)
         {
-            m_excludedAnimationsList.emplace_back(animName.data(), animName.length());
+            const auto length = bufBinaryWalker.Read<uint8_t>();
+            const auto chars = bufBinaryWalker.ReadArrayView<char>(length);
+            m_excludedAnimationsList.emplace_back(chars.data(), chars.size());
         }
 
         return true;
     }
 
-    bool GMS::LoadWeaponHandles(char* gmsBuffer, size_t gmsBufferSize, char* bufBuffer, size_t bufBufferSize)
+    bool GMS::LoadWeaponHandles(std::span<const uint8_t> gmsBody, std::span<const uint8_t> bufBody)
     {
-        auto weaponHandlesOffset = ((int*)gmsBuffer)[GMSOffsets::WeaponHandlesRegionAddr];
-        if (!weaponHandlesOffset)
+        m_weaponHandles = {};
+        m_weaponHandlesCount = 0;
+
+        BinaryReader gmsBinaryWalker(gmsBody.data(), gmsBody.size());
+        gmsBinaryWalker.Seek(GMSOffsets::WeaponHandlesRegionAddr * sizeof(uint32_t), BinaryReader::BEGIN);
+        const auto weaponHandlesOffset = gmsBinaryWalker.Read<uint32_t>();
+
+        if (!weaponHandlesOffset || weaponHandlesOffset >= bufBody.size())
         {
             // Note: I don't know how to check it more correctly but if weaponHandlesOffset == 0 we will have bad pointer
             return false;
         }
 
-        if (weaponHandlesOffset / sizeof(int) >= bufBufferSize)
+        BinaryReader bufBinaryWalker(bufBody.data(), bufBody.size(), weaponHandlesOffset);
+        m_weaponHandlesCount = bufBinaryWalker.Read<int32_t>();
+        if (m_weaponHandlesCount < 0)
         {
+            m_weaponHandlesCount = 0;
             return false;
         }
 
-        auto weaponHandlesCountPtr = (int*)&((int*)bufBuffer)[weaponHandlesOffset / sizeof(int)];
-
-        m_weaponHandlesCount = *weaponHandlesCountPtr;
-
-        auto weaponHandlesLocation = reinterpret_cast<char*>(weaponHandlesCountPtr + 1);
-
-        if (!m_weaponHandlesCount)
-        {
-            return true;
-        }
-
-        m_weaponHandles.reserve(m_weaponHandlesCount);
+        m_weaponHandles = ReadArrayViewOrCopy(bufBinaryWalker, m_weaponHandlesCount, m_weaponHandlesStorage);
+        return true;
+    }
 
-        auto handles = std::make_unique<GMSWeaponHandle[]>(m_weaponHandlesCount);
-        std::memcpy(handles.get(), weaponHandlesLocation, sizeof(GMSWeaponHandle) * m_weaponHandlesCount);
+    void GMS::ReleaseUncompressedBuffer()
+    {
+        // Views must go before their buffers
+        m_excludedAnimationsList.clear();
+        m_totalLinkRefsCount = 0;
+        m_linkRefs = {};
+        m_linkRefsStorage.clear();
+        m_weaponHandlesCount = 0;
+        m_weaponHandles = {};
+        m_weaponHandlesStorage.clear();
+        m_geoms.Clear();
+        m_isLoaded = false;
+
+        m_bufBuffer = nullptr;
+        m_bufBufferSize = 0;
+        m_rawBody = nullptr;
+        m_rawBodySize = 0;
+    }
 
-        for (int i = 0; i < m_weaponHandlesCount; i++)
+    std::shared_ptr<const uint8_t[]> GMS::GetRawGMS(size_t& outBufferSize)
+    {
+        if (m_rawBody)
         {
-            m_weaponHandles.emplace_back(handles[i].entityId, handles[i].m_field4, handles[i].m_field8);
+            outBufferSize = m_rawBodySize;
+            return m_rawBody;
         }
 
-        return true;
-    }
-
-    std::unique_ptr<uint8_t[]> GMS::GetRawGMS(size_t& outBufferSize)
-    {
         size_t bufferSize = 0;
-        auto buffer = m_container->Read(m_name, bufferSize);
+        auto buffer = m_container->ReadShared(m_name, bufferSize);
 
         if (!buffer) {
             spdlog::error("GMS::GetRawGMS() | Unable to read GMS file {}", m_name);
             return nullptr;
         }
 
-        // Uncompress (legacy, TODO: Refactor!)
-        auto raw = reinterpret_cast<char*>(buffer.get());
-
-        Legacy::GMS2 gms = { 0 };
-        gms.field_0 = 1;
-        gms.m_raw = (int)raw;
-
-        int v5 = *(int*)raw;
-
-        gms.field_C = v5;
-        gms.field_8 = *(unsigned int*)(raw + 4);
-        gms.field_14 = (*(unsigned char*)(raw + 8)) != 0;
+        auto outBuffer = ZPackedDecoder::Unpack(buffer.get(), bufferSize, outBufferSize, [](size_t size) {
+            return std::make_shared_for_overwrite<uint8_t[]>(size); // Body is overwritten by unpack, padding is zeroed by decoder
+        });
 
-        outBufferSize = (v5 + 15) & 0xFFFFFFF0;
-
-        auto outBuffer = std::make_unique<uint8_t[]>(outBufferSize);
-        Legacy::GMS_Decompress(&gms, outBuffer.get(), outBufferSize);
+        if (!outBuffer)
+        {
+            spdlog::error("GMS::GetRawGMS() | Unable to unpack GMS file {}", m_name);
+            return nullptr;
+        }
 
-        return std::move(outBuffer);
+        m_rawBody = std::move(outBuffer);
+        m_rawBodySize = outBufferSize;
+        return m_rawBody;
     }
 
     /**
@@ -0,0 +1,91 @@
+#include <GMS/GMSGeomIndex.h>
+#include <GMS/GMS.h>
+
+#include <algorithm>
+
+namespace ReGlacier
+{
+    /**
+     * @brief Sort geoms by key and split result into parallel arrays of keys and geom indices
+     */
+    template <typename TKey, typename TKeyGetter>
+    static void BuildSortedIndex(size_t geomsCount, TKeyGetter&& getKey, std::vector<TKey>& keys, std::vector<uint32_t>& geoms)
+    {
+        std::vector<std::pair<TKey, uint32_t>> pairs;
+        pairs.reserve(geomsCount);
+
+        for (size_t i = 0; i < geomsCount; i++)
+        {
+            pairs.emplace_back(getKey(i), static_cast<uint32_t>(i));
+        }
+
+        std::sort(pairs.begin(), pairs.end()); // (key, index) pairs are unique, so order of equal keys is by index
+
+        keys.reserve(geomsCount);
+        geoms.reserve(geomsCount);
+
+        for (const auto& [key, geom] : pairs)
+        {
+            keys.push_back(key);
+            geoms.push_back(geom);
+        }
+    }
+
+    GMSGeomIndex::GMSGeomIndex(const GMS* gms)
+    {
+        if (!gms)
+        {
+            return;
+        }
+
+        const auto& geoms = gms->GetGeoms();
+        const size_t geomsCount = geoms.GetSize();
+
+        for (size_t i = 0; i < geomsCount; i++)
+        {
+            m_byType[geoms.TypeIds[i]].push_back(static_cast<uint32_t>(i));
+        }
+
+        BuildSortedIndex(geomsCount, [gms](size_t i) { return gms->GetGeomName(i); }, m_names, m_byName);
+        BuildSortedIndex(geomsCount, [&geoms](size_t i) { return geoms.PRMOffsets[i]; }, m_prmOffsets, m_byPRMOffset);
+    }
+
+    std::span<const uint32_t> GMSGeomIndex::FindByType(uint32_t typeId) const
+    {
+        if (auto it = m_byType.find(typeId); it != m_byType.end())
+        {
+            return it->second;
+        }
+
+        return {};
+    }
+
+    std::span<const uint32_t> GMSGeomIndex::FindByNamePrefix(std::string_view prefix) const
+    {
+        const auto begin = std::lower_bound(m_names.begin(), m_names.end(), prefix);
+        const auto end = std::partition_point(begin, m_names.end(), [prefix](std::string_view name) { return name.starts_with(prefix); });
+
+        return std::span<const uint32_t>(m_byName).subspan(begin - m_names.begin(), end - begin);
+    }
+
+    std::span<const uint32_t> GMSGeomIndex::FindByPRMOffset(uint32_t prmOffset) const
+    {
+        const auto [begin, end] = std::equal_range(m_prmOffsets.begin(), m_prmOffsets.end(), prmOffset);
+
+        return std::span<const uint32_t>(m_byPRMOffset).subspan(begin - m_prmOffsets.begin(), end - begin);
+    }
+
+    std::vector<uint32_t> GMSGeomIndex::GetTypeIds() const
+    {
+        std::vector<uint32_t> typeIds;
+        typeIds.reserve(m_byType.size());
+
+        for (const auto& [typeId, geoms] : m_byType)
+        {
+            typeIds.push_back(typeId);
+        }
+
+        std::sort(typeIds.begin(), typeIds.end());
+        return typeIds;
+    }
+}
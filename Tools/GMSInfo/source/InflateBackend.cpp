@@ -0,0 +1,179 @@
+#include <InflateBackend.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <limits>
+
+#ifdef GMSTOOL_USE_LIBDEFLATE
+#   include <libdeflate.h>
+#else
+extern "C" {
+#   include <zlib.h>
+}
+#endif
+
+namespace ReGlacier::InflateBackend
+{
+#ifdef GMSTOOL_USE_LIBDEFLATE
+    /**
+     * @brief Decompressor of the current thread (libdeflate decompressors are not thread safe but reusable)
+     */
+    class ThreadDecompressor
+    {
+        libdeflate_decompressor* m_decompressor { libdeflate_alloc_decompressor() };
+
+    public:
+        ThreadDecompressor() = default;
+        ~ThreadDecompressor() { if (m_decompressor) libdeflate_free_decompressor(m_decompressor); }
+
+        ThreadDecompressor(const ThreadDecompressor&) = delete;
+        ThreadDecompressor& operator=(const ThreadDecompressor&) = delete;
+
+        [[nodiscard]] libdeflate_decompressor* Get() const { return m_decompressor; }
+    };
+
+    const char* GetName()
+    {
+        return "libdeflate";
+    }
+
+    bool InflateRaw(const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize, size_t& writtenBytes)
+    {
+        writtenBytes = 0;
+
+        static thread_local ThreadDecompressor s_decompressor;
+        if (!s_decompressor.Get())
+        {
+            spdlog::error("InflateBackend| libdeflate_alloc_decompressor() failed");
+            return false;
+        }
+
+        const auto result = libdeflate_deflate_decompress(s_decompressor.Get(), input, inputSize, output, outputSize, &writtenBytes);
+        if (result != LIBDEFLATE_SUCCESS)
+        {
+            spdlog::error("InflateBackend| libdeflate_deflate_decompress() failed with error code {}", static_cast<int>(result));
+            return false;
+        }
+
+        return true;
+    }
+
+    uint32_t Crc32(const uint8_t* buffer, size_t size)
+    {
+        return libdeflate_crc32(0, buffer, size);
+    }
+#else
+    static constexpr int kZlibRawDeflateWindowBits = -15;
+
+    /**
+     * @brief Inflate state of the current thread (reset instead of init/end on every call)
+     */
+    class ThreadInflateState
+    {
+        z_stream m_stream {};
+        bool m_isInitialized { false };
+
+    public:
+        ThreadInflateState() = default;
+
+        ~ThreadInflateState()
+        {
+            if (m_isInitialized)
+            {
+                inflateEnd(&m_stream);
+            }
+        }
+
+        ThreadInflateState(const ThreadInflateState&) = delete;
+        ThreadInflateState& operator=(const ThreadInflateState&) = delete;
+
+        /**
+         * @return stream ready for the new input or nullptr if zlib failed
+         */
+        z_stream* Acquire()
+        {
+            if (!m_isInitialized)
+            {
+                m_stream.zalloc = Z_NULL;
+                m_stream.zfree = Z_NULL;
+                m_stream.opaque = Z_NULL;
+
+                const int ret = inflateInit2(&m_stream, kZlibRawDeflateWindowBits);
+                if (ret != Z_OK)
+                {
+                    spdlog::error("InflateBackend| inflateInit2() failed with error code {}", ret);
+                    return nullptr;
+                }
+
+                m_isInitialized = true;
+                return &m_stream;
+            }
+
+            const int ret = inflateReset(&m_stream);
+            if (ret != Z_OK)
+            {
+                spdlog::error("InflateBackend| inflateReset() failed with error code {}", ret);
+                return nullptr;
+            }
+
+            return &m_stream;
+        }
+    };
+
+    const char* GetName()
+    {
+        return "zlib";
+    }
+
+    bool InflateRaw(const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize, size_t& writtenBytes)
+    {
+        writtenBytes = 0;
+
+        if (inputSize > std::numeric_limits<uInt>::max() || outputSize > std::numeric_limits<uInt>::max())
+        {
+            spdlog::error("InflateBackend| Buffer is too big for single inflate call ({} -> {} bytes)", inputSize, outputSize);
+            return false;
+        }
+
+        static thread_local ThreadInflateState s_state;
+
+        z_stream* stream = s_state.Acquire();
+        if (!stream)
+        {
+            return false;
+        }
+
+        stream->next_in = const_cast<Bytef*>(input);
+        stream->avail_in = static_cast<uInt>(inputSize);
+        stream->next_out = output;
+        stream->avail_out = static_cast<uInt>(outputSize);
+
+        const int ret = inflate(stream, Z_FINISH);
+        writtenBytes = outputSize - stream->avail_out;
+
+        if (ret == Z_STREAM_END || (ret == Z_BUF_ERROR && !stream->avail_out))
+        {
+            return true;
+        }
+
+        spdlog::error("InflateBackend| inflate() failed with error code {}", ret);
+        return false;
+    }
+
+    uint32_t Crc32(const uint8_t* buffer, size_t size)
+    {
+        uLong crc = crc32(0L, Z_NULL, 0);
+
+        // zlib takes uInt sizes, so feed huge buffers by parts
+        while (size > 0)
+        {
+            const auto chunkSize = static_cast<uInt>(std::min<size_t>(size, std::numeric_limits<uInt>::max()));
+            crc = crc32(crc, buffer, chunkSize);
+            buffer += chunkSize;
+            size -= chunkSize;
+        }
+
+        return static_cast<uint32_t>(crc);
+    }
+#endif
+}
@@ -37,4 +37,19 @@ namespace ReGlacier
         else if (nameInLowerCase.ends_with("zgf")) ZGF = path;
         else spdlog::warn("Assets::TryResolve| File {} ignored", path);
     }
-}
\ No newline at end of file
+
+    std::vector<std::string> LevelAssets::GetResolvedPaths() const
+    {
+        std::vector<std::string> paths;
+
+        for (const std::string* path : { &ANM, &BUF, &GMS, &LOC, &MAT, &OCT, &PRP, &PRM, &RMC, &RMI, &SGD, &SGP, &SND, &SUP, &TEX, &ZGF })
+        {
+            if (!path->empty())
+            {
+                paths.push_back(*path);
+            }
+        }
+
+        return paths;
+    }
+}
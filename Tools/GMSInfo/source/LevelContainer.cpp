@@ -1,24 +1,116 @@
 #include <LevelContainer.h>
+#include <InflateBackend.h>
+#include <ThreadPool.h>
+#include <TaskGraph.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
 extern "C" {
 #include <unzip.h>
 }
 
 namespace ReGlacier
 {
-    LevelContainer::LevelContainer(void* zipPtr) : m_zip(zipPtr)
+    // ZIP format constants (APPNOTE.TXT 4.3.7 & 4.3.12)
+    static constexpr uint32_t kCentralFileHeaderSignature = 0x02014b50;
+    static constexpr uint32_t kLocalFileHeaderSignature   = 0x04034b50;
+    static constexpr size_t kCentralFileHeaderSize        = 46;
+    static constexpr size_t kLocalFileHeaderSize          = 30;
+    static constexpr uint16_t kEncryptedFileFlag          = 0x1;
+
+    template <typename T>
+    static T ReadLittleEndian(const uint8_t* data)
+    {
+        T value {};
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+            value |= static_cast<T>(data[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    /**
+     * @brief Exclusive ownership of the archive handle until end of scope
+     */
+    class LevelContainer::HandleLease
+    {
+        LevelContainer* m_owner;
+        void* m_handle;
+
+    public:
+        explicit HandleLease(LevelContainer* owner) : m_owner(owner), m_handle(owner->AcquireHandle()) {}
+        ~HandleLease() { if (m_handle) m_owner->ReleaseHandle(m_handle); }
+
+        HandleLease(const HandleLease&) = delete;
+        HandleLease& operator=(const HandleLease&) = delete;
+
+        [[nodiscard]] unzFile Get() const { return m_handle; }
+    };
+
+    LevelContainer::LevelContainer(std::string archivePath) : m_archivePath(std::move(archivePath))
     {}
 
-    std::unique_ptr<uint8_t[]> LevelContainer::Read(std::string_view path, size_t& bufferSize)
+    LevelContainer::~LevelContainer()
     {
-        bufferSize = 0;
-        unzFile zip = m_zip;
+        for (auto handle : m_handles)
+        {
+            unzClose(handle);
+        }
+
+        m_handles.clear();
+        m_freeHandles.clear();
+    }
 
-        if (unzGoToFirstFile(zip) != UNZ_OK)
+    bool LevelContainer::Open()
+    {
+        HandleLease lease { this };
+        if (!lease.Get())
         {
-            spdlog::error("Failed to open {} file in level archive", path);
-            return nullptr;
+            return false;
+        }
+
+        // Mapping is optional: without it stored files are just copied through minizip
+        m_mapping = std::make_shared<MappedFile>(m_archivePath);
+        if (!m_mapping->Open())
+        {
+            spdlog::warn("LevelContainer::Open| Unable to map archive {} into memory. Zero-copy reads are disabled", m_archivePath);
+            m_mapping = nullptr;
+        }
+
+        return true;
+    }
+
+    bool LevelContainer::BuildIndex()
+    {
+        HandleLease lease { this };
+        unzFile zip = lease.Get();
+
+        if (!zip)
+        {
+            spdlog::error("LevelContainer::BuildIndex| Archive {} is not opened", m_archivePath);
+            return false;
+        }
+
+        m_index.clear();
+        m_entryNames.clear();
+
+        unz_global_info globalInfo;
+        if (unzGetGlobalInfo(zip, &globalInfo) == UNZ_OK)
+        {
+            m_index.reserve(globalInfo.number_entry);
+            m_entryNames.reserve(globalInfo.number_entry);
+        }
+
+        int ret = unzGoToFirstFile(zip);
+        if (ret != UNZ_OK)
+        {
+            spdlog::error("LevelContainer::BuildIndex| unzGoToFirstFile() failed with error code {}", ret);
+            return false;
         }
 
         do {
@@ -26,55 +118,580 @@ namespace ReGlacier
             char fileName[kMaxFileNameLength] = { 0 };
             unz_file_info fileInfo;
 
-            unsigned int ret = unzGetCurrentFileInfo(
-                    zip,
-                    &fileInfo,
-                    fileName,
-                    kMaxFileNameLength,
-                    nullptr,0, nullptr, 0);
+            ret = unzGetCurrentFileInfo(zip, &fileInfo, fileName, kMaxFileNameLength, nullptr, 0, nullptr, 0);
             if (ret != UNZ_OK)
             {
-                spdlog::error("LevelContainer::Read| unzGetCurrentFileInfo() failed with error code {}", ret);
-                return nullptr;
+                spdlog::error("LevelContainer::BuildIndex| unzGetCurrentFileInfo() failed with error code {}", ret);
+                return false;
             }
 
-            if (std::string_view(fileName) == path)
+            unz_file_pos filePos;
+            ret = unzGetFilePos(zip, &filePos);
+            if (ret != UNZ_OK)
+            {
+                spdlog::error("LevelContainer::BuildIndex| unzGetFilePos() failed for file {} with error code {}", fileName, ret);
+                return false;
+            }
+
+            auto [it, isInserted] = m_index.try_emplace(fileName);
+            if (isInserted)
+            {
+                // Data offset is not resolved here: local headers are spread over the whole archive
+                Entry& entry = it->second;
+                entry.PosInZipDirectory = filePos.pos_in_zip_directory;
+                entry.NumFile = filePos.num_of_file;
+                entry.CompressedSize = fileInfo.compressed_size;
+                entry.UncompressedSize = fileInfo.uncompressed_size;
+                entry.CompressionMethod = static_cast<int>(fileInfo.compression_method);
+                entry.Crc32 = static_cast<uint32_t>(fileInfo.crc);
+
+                m_entryNames.push_back(it->first);
+            }
+            else
             {
-                ret = unzOpenCurrentFile(zip);
-                if (ret != UNZ_OK)
+                spdlog::warn("LevelContainer::BuildIndex| Duplicated file {} in level archive. Only first entry will be used", fileName);
+            }
+
+            ret = unzGoToNextFile(zip);
+        } while (ret == UNZ_OK);
+
+        if (ret != UNZ_END_OF_LIST_OF_FILE)
+        {
+            spdlog::error("LevelContainer::BuildIndex| unzGoToNextFile() failed with error code {}", ret);
+            return false;
+        }
+
+        return true;
+    }
+
+    const std::string& LevelContainer::GetArchivePath() const
+    {
+        return m_archivePath;
+    }
+
+    const std::vector<std::string>& LevelContainer::GetEntryNames() const
+    {
+        return m_entryNames;
+    }
+
+    const LevelContainer::Entry* LevelContainer::FindEntry(std::string_view path) const
+    {
+        auto it = m_index.find(path);
+        return it != std::end(m_index) ? &it->second : nullptr;
+    }
+
+    std::span<const uint8_t> LevelContainer::GetStoredView(std::string_view path) const
+    {
+        const Entry* entry = FindEntry(path);
+        if (!m_mapping || !entry || entry->CompressionMethod != kStoredCompressionMethod)
+        {
+            return {};
+        }
+
+        const size_t dataOffset = GetDataOffset(*entry);
+        if (!dataOffset)
+        {
+            return {};
+        }
+
+        return m_mapping->GetRange(dataOffset, entry->UncompressedSize);
+    }
+
+    std::unique_ptr<uint8_t[]> LevelContainer::Read(std::string_view path, size_t& bufferSize)
+    {
+        bufferSize = 0;
+
+        const Entry* entry = FindEntry(path);
+        if (!entry)
+        {
+            spdlog::warn("LevelContainer::Read| File {} not found in level archive", path);
+            return nullptr;
+        }
+
+        if (auto storedView = GetStoredView(path); !storedView.empty())
+        {
+            // Nothing to inflate, just copy from mapped archive
+            auto buffer = std::make_unique<uint8_t[]>(storedView.size());
+            std::memcpy(buffer.get(), storedView.data(), storedView.size());
+
+            bufferSize = storedView.size();
+            return buffer;
+        }
+
+        auto buffer = std::make_unique<uint8_t[]>(entry->UncompressedSize);
+
+        if (InflateMappedEntry(path, *entry, buffer.get()))
+        {
+            bufferSize = entry->UncompressedSize;
+            return buffer;
+        }
+
+        HandleLease lease { this };
+        if (!lease.Get())
+        {
+            spdlog::error("LevelContainer::Read| Unable to read file {}. No available archive handle", path);
+            return nullptr;
+        }
+
+        if (!ReadEntryWithHandle(lease.Get(), path, *entry, buffer.get(), bufferSize))
+        {
+            return nullptr;
+        }
+
+        if (entry->UncompressedSize != bufferSize)
+        {
+            spdlog::warn("LevelContainer::Read| File read operation got wrong buffer size. Await {} got {}", entry->UncompressedSize, bufferSize);
+        }
+
+        return buffer;
+    }
+
+    std::vector<LevelContainer::ReadResult> LevelContainer::ReadMany(std::span<const std::string> paths, ThreadPool& pool)
+    {
+        std::vector<ReadResult> results(paths.size());
+
+        TaskGraph graph;
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            graph.AddTask(paths[i], [this, &results, &paths, i]() {
+                auto& result = results[i];
+
+                if (auto storedView = GetStoredView(paths[i]); !storedView.empty())
                 {
-                    spdlog::error("LevelContainer::Read| Unable to open file {}. unzOpenCurrentFile() failed with error code {}", path, ret);
-                    return nullptr;
+                    result.Buffer = ConstBuffer(m_mapping, storedView.data());
+                    result.BufferSize = storedView.size();
                 }
+                else
+                {
+                    result.Buffer = Read(paths[i], result.BufferSize);
+                }
+            });
+        }
+
+        graph.Run(pool);
+        return results;
+    }
+
+    LevelContainer::InflateStream::Ptr LevelContainer::OpenStream(std::string_view path)
+    {
+        const Entry* entry = FindEntry(path);
+        if (!entry)
+        {
+            spdlog::warn("LevelContainer::OpenStream| File {} not found in level archive", path);
+            return nullptr;
+        }
+
+        // Handle will be returned to the pool by the stream
+        unzFile zip = AcquireHandle();
+        if (!zip)
+        {
+            spdlog::error("LevelContainer::OpenStream| Unable to open file {}. No available archive handle", path);
+            return nullptr;
+        }
+
+        unz_file_pos filePos;
+        filePos.pos_in_zip_directory = entry->PosInZipDirectory;
+        filePos.num_of_file = entry->NumFile;
+
+        int ret = unzGoToFilePos(zip, &filePos);
+        if (ret != UNZ_OK)
+        {
+            spdlog::error("LevelContainer::OpenStream| unzGoToFilePos() failed for file {} with error code {}", path, ret);
+            ReleaseHandle(zip);
+            return nullptr;
+        }
+
+        ret = unzOpenCurrentFile(zip);
+        if (ret != UNZ_OK)
+        {
+            spdlog::error("LevelContainer::OpenStream| Unable to open file {}. unzOpenCurrentFile() failed with error code {}", path, ret);
+            ReleaseHandle(zip);
+            return nullptr;
+        }
+
+        return InflateStream::Ptr(new InflateStream(this, zip, std::string(path), entry->UncompressedSize));
+    }
+
+    LevelContainer::ConstBuffer LevelContainer::ReadShared(std::string_view path, size_t& bufferSize)
+    {
+        bufferSize = 0;
+
+        if (auto storedView = GetStoredView(path); !storedView.empty())
+        {
+            // Zero copy: buffer shares ownership of the mapping
+            bufferSize = storedView.size();
+            return ConstBuffer(m_mapping, storedView.data());
+        }
+
+        std::string key { path };
+        std::unique_lock<std::mutex> lock { m_cacheMutex };
+
+        if (auto it = m_cache.find(key); it != std::end(m_cache))
+        {
+            // Move to the head of LRU list
+            m_lru.splice(std::begin(m_lru), m_lru, it->second.LRUPosition);
+
+            auto asset = it->second.Asset;
+            lock.unlock();
+
+            const CachedAsset& cachedAsset = asset.get(); // Wait if somebody inflating it right now
+            bufferSize = cachedAsset.BufferSize;
+            return cachedAsset.Buffer;
+        }
+
+        const Entry* entry = FindEntry(path);
+        if (!entry || entry->UncompressedSize > m_cacheBudget)
+        {
+            // Not found or too big to be cached: caller will be the only owner
+            lock.unlock();
+            return Read(path, bufferSize);
+        }
+
+        const size_t reservedSize = entry->UncompressedSize;
+        EvictCachedBuffers(m_cacheBudget - reservedSize);
+
+        std::promise<CachedAsset> promise;
+        m_lru.push_front(key);
+
+        CacheEntry& cacheEntry = m_cache[key];
+        cacheEntry.Asset = promise.get_future().share();
+        cacheEntry.BufferSize = reservedSize;
+        cacheEntry.LRUPosition = std::begin(m_lru);
+
+        m_cacheUsage += reservedSize;
+        lock.unlock();
 
-                auto buffer = std::make_unique<uint8_t[]>(fileInfo.uncompressed_size);
-                int readBytes = unzReadCurrentFile(zip, buffer.get(), fileInfo.uncompressed_size);
+        // Inflate out of lock
+        CachedAsset asset;
+        asset.Buffer = Read(path, asset.BufferSize);
+        promise.set_value(asset);
 
-                if (readBytes < 0)
+        if (!asset.Buffer)
+        {
+            // Do not keep failed reads in the cache
+            lock.lock();
+
+            // Entry could be already evicted and re-requested by other reader, so remove only our own failed entry
+            if (auto it = m_cache.find(key);
+                it != std::end(m_cache) &&
+                it->second.Asset.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+                !it->second.Asset.get().Buffer)
+            {
+                m_cacheUsage -= it->second.BufferSize;
+                m_lru.erase(it->second.LRUPosition);
+                m_cache.erase(it);
+            }
+
+            return nullptr;
+        }
+
+        bufferSize = asset.BufferSize;
+        return asset.Buffer;
+    }
+
+    bool LevelContainer::ForEachEntry(const EntryVisitor& visitor)
+    {
+        // Order of data in the archive (entries with unknown location keep central directory order at the end)
+        std::vector<std::tuple<size_t, const std::string*, const Entry*>> entries;
+        entries.reserve(m_entryNames.size());
+
+        size_t maxUncompressedSize = 0;
+        for (const auto& name : m_entryNames)
+        {
+            const Entry& entry = m_index.at(name);
+            const size_t dataOffset = GetDataOffset(entry);
+
+            entries.emplace_back(dataOffset ? dataOffset : std::numeric_limits<size_t>::max(), &name, &entry);
+            maxUncompressedSize = std::max(maxUncompressedSize, entry.UncompressedSize);
+        }
+
+        std::stable_sort(std::begin(entries), std::end(entries), [](const auto& lhs, const auto& rhs) {
+            return std::get<0>(lhs) < std::get<0>(rhs);
+        });
+
+        HandleLease lease { this };
+        if (!lease.Get())
+        {
+            spdlog::error("LevelContainer::ForEachEntry| No available archive handle");
+            return false;
+        }
+
+        auto buffer = std::make_unique<uint8_t[]>(maxUncompressedSize);
+        bool isAllRead = true;
+
+        for (const auto& [dataOffset, name, entry] : entries)
+        {
+            std::span<const uint8_t> contents = GetStoredView(*name);
+
+            if (contents.empty() && entry->UncompressedSize)
+            {
+                size_t readBytes = entry->UncompressedSize;
+
+                if (!InflateMappedEntry(*name, *entry, buffer.get()) &&
+                    !ReadEntryWithHandle(lease.Get(), *name, *entry, buffer.get(), readBytes))
                 {
-                    spdlog::error("LevelContainer::Read| unzReadCurrentFile() failed for file {} with error code {}", path, readBytes);
-                    return nullptr;
+                    isAllRead = false;
+                    continue;
                 }
 
-                bufferSize = readBytes;
-
-                if (fileInfo.uncompressed_size != bufferSize)
+                if (readBytes != entry->UncompressedSize)
                 {
-                    spdlog::warn("LevelContainer::Read| File read operation got wrong buffer size. Await {} got {}", fileInfo.uncompressed_size, bufferSize);
+                    spdlog::warn("LevelContainer::ForEachEntry| File read operation got wrong buffer size. Await {} got {}", entry->UncompressedSize, readBytes);
                 }
 
-                return std::move(buffer);
+                contents = { buffer.get(), readBytes };
             }
 
-            ret = unzGoToNextFile(zip);
-            if (ret != UNZ_OK)
+            if (!visitor(*name, *entry, contents))
+            {
+                return false;
+            }
+        }
+
+        return isAllRead;
+    }
+
+    void LevelContainer::SetCacheBudget(size_t budget)
+    {
+        std::lock_guard<std::mutex> lock { m_cacheMutex };
+
+        m_cacheBudget = budget;
+        EvictCachedBuffers(m_cacheBudget);
+    }
+
+    void LevelContainer::ClearCache()
+    {
+        std::lock_guard<std::mutex> lock { m_cacheMutex };
+
+        m_cache.clear();
+        m_lru.clear();
+        m_cacheUsage = 0;
+    }
+
+    LevelContainer::InflateStream::InflateStream(LevelContainer* owner, void* handle, std::string path, size_t size)
+        : m_owner(owner)
+        , m_handle(handle)
+        , m_path(std::move(path))
+        , m_size(size)
+    {}
+
+    LevelContainer::InflateStream::~InflateStream()
+    {
+        // CRC is checked by minizip only when the whole file was read
+        const int ret = unzCloseCurrentFile(m_handle);
+        if (ret == UNZ_CRCERROR)
+        {
+            spdlog::warn("LevelContainer::InflateStream| CRC mismatch in file {}", m_path);
+        }
+
+        m_owner->ReleaseHandle(m_handle);
+    }
+
+    size_t LevelContainer::InflateStream::Read(uint8_t* buffer, size_t size)
+    {
+        size_t totalRead = 0;
+
+        while (totalRead < size)
+        {
+            const auto chunkSize = static_cast<unsigned>(std::min<size_t>(size - totalRead, std::numeric_limits<unsigned>::max()));
+            const int readBytes = unzReadCurrentFile(m_handle, buffer + totalRead, chunkSize);
+
+            if (readBytes < 0)
             {
-                spdlog::warn("LevelContainer::Read| File {} not found in level archive. unzGoToNextFile() = {}", path, ret);
-                return nullptr;
+                throw std::runtime_error { fmt::format("unzReadCurrentFile() failed for file {} with error code {}", m_path, readBytes) };
             }
+
+            if (readBytes == 0)
+            {
+                break; // End of file
+            }
+
+            totalRead += readBytes;
         }
-        while (true);
 
-        return nullptr;
+        m_position += totalRead;
+        return totalRead;
+    }
+
+    size_t LevelContainer::InflateStream::GetSize() const
+    {
+        return m_size;
+    }
+
+    size_t LevelContainer::InflateStream::GetPosition() const
+    {
+        return m_position;
+    }
+
+    const std::string& LevelContainer::InflateStream::GetPath() const
+    {
+        return m_path;
     }
-}
\ No newline at end of file
+
+    void* LevelContainer::AcquireHandle()
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_handlesMutex };
+
+            if (!m_freeHandles.empty())
+            {
+                void* handle = m_freeHandles.back();
+                m_freeHandles.pop_back();
+                return handle;
+            }
+        }
+
+        // Each handle has own file descriptor and own state, so it could be used in parallel with others
+        unzFile handle = unzOpen(m_archivePath.c_str());
+        if (!handle)
+        {
+            spdlog::error("LevelContainer::AcquireHandle| Unable to open level archive {}", m_archivePath);
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock { m_handlesMutex };
+        m_handles.push_back(handle);
+        return handle;
+    }
+
+    void LevelContainer::ReleaseHandle(void* handle)
+    {
+        std::lock_guard<std::mutex> lock { m_handlesMutex };
+        m_freeHandles.push_back(handle);
+    }
+
+    size_t LevelContainer::GetDataOffset(const Entry& entry) const
+    {
+        size_t dataOffset = entry.DataOffset.load(std::memory_order_relaxed);
+        if (dataOffset == Entry::kUnresolvedDataOffset)
+        {
+            // Concurrent readers of the same entry resolve the same value, so the last store wins without harm
+            dataOffset = LocateEntryData(entry.PosInZipDirectory);
+            entry.DataOffset.store(dataOffset, std::memory_order_relaxed);
+        }
+
+        return dataOffset;
+    }
+
+    size_t LevelContainer::LocateEntryData(unsigned long posInCentralDirectory) const
+    {
+        if (!m_mapping)
+        {
+            return 0;
+        }
+
+        // NOTE: We are expecting that archive has no prepended data (true for all game archives)
+        auto centralHeader = m_mapping->GetRange(posInCentralDirectory, kCentralFileHeaderSize);
+        if (centralHeader.empty() || ReadLittleEndian<uint32_t>(centralHeader.data()) != kCentralFileHeaderSignature)
+        {
+            return 0;
+        }
+
+        const auto flags = ReadLittleEndian<uint16_t>(centralHeader.data() + 8);
+        if (flags & kEncryptedFileFlag)
+        {
+            return 0;
+        }
+
+        const auto localHeaderOffset = ReadLittleEndian<uint32_t>(centralHeader.data() + 42);
+        auto localHeader = m_mapping->GetRange(localHeaderOffset, kLocalFileHeaderSize);
+        if (localHeader.empty() || ReadLittleEndian<uint32_t>(localHeader.data()) != kLocalFileHeaderSignature)
+        {
+            return 0;
+        }
+
+        const auto fileNameLength = ReadLittleEndian<uint16_t>(localHeader.data() + 26);
+        const auto extraFieldLength = ReadLittleEndian<uint16_t>(localHeader.data() + 28);
+
+        return localHeaderOffset + kLocalFileHeaderSize + fileNameLength + extraFieldLength;
+    }
+
+    bool LevelContainer::InflateMappedEntry(std::string_view path, const Entry& entry, uint8_t* output)
+    {
+        // Whole compressed stream is in memory and output size is known, so it could be inflated in one shot
+        if (!m_mapping || entry.CompressionMethod != kDeflatedCompressionMethod)
+        {
+            return false;
+        }
+
+        const size_t dataOffset = GetDataOffset(entry);
+        if (!dataOffset)
+        {
+            return false;
+        }
+
+        auto compressed = m_mapping->GetRange(dataOffset, entry.CompressedSize);
+        if (compressed.empty() && entry.CompressedSize)
+        {
+            return false;
+        }
+
+        size_t writtenBytes = 0;
+        if (!InflateBackend::InflateRaw(compressed.data(), compressed.size(), output, entry.UncompressedSize, writtenBytes) ||
+            writtenBytes != entry.UncompressedSize ||
+            InflateBackend::Crc32(output, writtenBytes) != entry.Crc32)
+        {
+            spdlog::warn("LevelContainer::InflateMappedEntry| Failed to inflate file {} from mapped archive, fallback to minizip", path);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool LevelContainer::ReadEntryWithHandle(void* handle, std::string_view path, const Entry& entry, uint8_t* output, size_t& readBytes)
+    {
+        readBytes = 0;
+
+        unz_file_pos filePos;
+        filePos.pos_in_zip_directory = entry.PosInZipDirectory;
+        filePos.num_of_file = entry.NumFile;
+
+        int ret = unzGoToFilePos(handle, &filePos);
+        if (ret != UNZ_OK)
+        {
+            spdlog::error("LevelContainer::ReadEntryWithHandle| unzGoToFilePos() failed for file {} with error code {}", path, ret);
+            return false;
+        }
+
+        ret = unzOpenCurrentFile(handle);
+        if (ret != UNZ_OK)
+        {
+            spdlog::error("LevelContainer::ReadEntryWithHandle| Unable to open file {}. unzOpenCurrentFile() failed with error code {}", path, ret);
+            return false;
+        }
+
+        const int result = unzReadCurrentFile(handle, output, static_cast<unsigned>(entry.UncompressedSize));
+        const int closeResult = unzCloseCurrentFile(handle); // CRC is checked by minizip only when the whole file was read
+
+        if (result < 0)
+        {
+            spdlog::error("LevelContainer::ReadEntryWithHandle| unzReadCurrentFile() failed for file {} with error code {}", path, result);
+            return false;
+        }
+
+        if (closeResult == UNZ_CRCERROR)
+        {
+            spdlog::error("LevelContainer::ReadEntryWithHandle| CRC mismatch in file {}", path);
+            return false;
+        }
+
+        readBytes = static_cast<size_t>(result);
+        return true;
+    }
+
+    void LevelContainer::EvictCachedBuffers(size_t budget)
+    {
+        // NOTE: m_cacheMutex must be locked by caller
+        while (m_cacheUsage > budget && !m_lru.empty())
+        {
+            auto it = m_cache.find(m_lru.back());
+            if (it != std::end(m_cache))
+            {
+                m_cacheUsage -= it->second.BufferSize;
+                m_cache.erase(it);
+            }
+
+            m_lru.pop_back();
+        }
+    }
+}
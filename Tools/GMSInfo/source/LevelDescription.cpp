@@ -1,25 +1,32 @@
 #include <LevelDescription.h>
 #include <LevelContainer.h>
 #include <LevelAssets.h>
+#include <ThreadPool.h>
+#include <TaskGraph.h>
 
 #include <GameEntityFactory.h>
+#include <Report/IReportWriter.h>
 
 #include <ANM/ANM.h>
 #include <GMS/GMS.h>
+#include <GMS/GMSGeomIndex.h>
 #include <PRM/PRM.h>
 #include <PRP/PRP.h>
 #include <TEX/TEX.h>
 #include <SND/SND.h>
 #include <LOC/LOC.h>
 
+#include <TypesDataBase.h>
+
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <atomic>
 #include <array>
-
-extern "C" {
-#include <unzip.h>
-}
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
 
 namespace ReGlacier
 {
@@ -50,8 +57,11 @@ namespace ReGlacier
         LOC::Ptr LOCInstance;
 
         std::array<bool, kTotalFlags> Flags {};
+        size_t WorkersCount { ThreadPool::GetDefaultWorkersCount() };
+        ParseDiagnostics Diagnostics {};
 
-        unzFile Zip { nullptr };
+        std::optional<std::once_flag> GeomIndexOnce { std::in_place }; ///< Re-created when GMS is replaced
+        std::unique_ptr<GMSGeomIndex> GeomIndex; ///< Built on the first geom query, nullptr while GMS is not loaded
 
         Context()
         {
@@ -64,13 +74,11 @@ namespace ReGlacier
             Flags[IgnoreFlags::IgnoreSND] = false;
         }
 
-        ~Context()
+        void ResetGeomIndex()
         {
-            if (Zip)
-            {
-                unzClose(Zip);
-                Zip = nullptr;
-            }
+            // Index holds views into the GMS body, so it must be dropped before GMS is replaced or released
+            GeomIndex = nullptr;
+            GeomIndexOnce.emplace();
         }
     };
 
@@ -102,91 +110,133 @@ namespace ReGlacier
             return false;
         }
 
-        m_context->Zip = unzOpen(m_context->ArchivePath.c_str());
-        if (!m_context->Zip)
+        m_context->Container = std::make_unique<LevelContainer>(m_context->ArchivePath);
+        if (!m_context->Container->Open())
         {
             spdlog::error("Unable to open level archive {}", m_context->ArchivePath);
+            m_context->Container = nullptr;
             return false;
         }
 
         return ValidateLevelArchive();
     }
 
-    void LevelDescription::LoadAndAnalyze()
+    bool LevelDescription::LoadAndAnalyze()
     {
-        if (!m_context)
+        if (!m_context || !m_context->Container)
         {
             spdlog::error("LevelDescription::LoadAndAnalyze| Unable to analyze level. Context not inited!");
-            return;
+            return false;
         }
 
-        m_context->Container = std::make_unique<LevelContainer>(m_context->Zip);
+        m_context->ResetGeomIndex();
+
+        /**
+         * Each asset parser is independent, so we are loading them in parallel.
+         * Only GMS requires BUF: it's prefetched into the container cache by separated task, so BUF is inflated in parallel with GMS body.
+         * LevelContainer gives own archive handle for each concurrent reader.
+         */
+        TaskGraph graph;
+        std::atomic<bool> isAllLoaded { true };
+
+        auto prefetch = [this, &isAllLoaded](const std::string& path) {
+            return [this, &isAllLoaded, path]() {
+                size_t bufferSize = 0;
+                if (!m_context->Container->ReadShared(path, bufferSize))
+                {
+                    spdlog::error("LevelDescription::Analyze| Failed to prefetch {}", path);
+                    isAllLoaded = false;
+                }
+            };
+        };
 
-        if (!m_context->Flags[IgnoreFlags::IgnoreLOC]) {
-            m_context->LOCInstance = GameEntityFactory::Create<LOC>(m_context->Assets.LOC, m_context);
-            if (!m_context->LOCInstance->Load())
+        auto addEntityLoadTask = [this, &graph, &isAllLoaded]<typename T>(const char* kind, IgnoreFlags ignoreFlag, const std::string& path, std::unique_ptr<T>& instance, std::initializer_list<TaskGraph::TaskId> dependencies) {
+            if (m_context->Flags[ignoreFlag])
             {
-                spdlog::error("LevelDescription::Analyze| Failed to load LOC to analyze!");
+                spdlog::info(" * {} ignored by user", kind);
+                return;
             }
-        } else spdlog::info(" * LOC ignored by user");
 
-        if (!m_context->Flags[IgnoreFlags::IgnorePRP]) {
-            m_context->PRPInstance = GameEntityFactory::Create<PRP>(m_context->Assets.PRP, m_context);
-            if (!m_context->PRPInstance->Load()) {
-                spdlog::error("LevelDescription::Analyze| Failed to load PRM to analyze!");
+            instance = GameEntityFactory::Create<T>(path, m_context);
+            if (!instance)
+            {
+                spdlog::error("LevelDescription::Analyze| {} not found in level archive!", kind);
+                isAllLoaded = false;
+                return;
             }
-        } else spdlog::info(" * PRP ignored by user");
 
-        if (!m_context->Flags[IgnoreFlags::IgnoreANM]) {
-            m_context->ANMInstance = GameEntityFactory::Create<ANM>(m_context->Assets.ANM, m_context);
-            if (!m_context->ANMInstance->Load()) {
-                spdlog::error("LevelDescription::Analyze| Failed to load ANM to analyze!");
-            }
-        } else spdlog::info(" * ANM ignored by user");
+            instance->SetParseDiagnostics(m_context->Diagnostics);
 
-        if (!m_context->Flags[IgnoreFlags::IgnoreSND]) {
-            m_context->SNDInstance = GameEntityFactory::Create<SND>(m_context->Assets.SND, m_context);
-            if (!m_context->SNDInstance->Load()) {
-                spdlog::error("LevelDescription::Analyze| Failed to load SND to analyze!");
-            }
-        } else spdlog::info(" * SND ignored by user");
+            graph.AddTask(kind, [kind, entity = instance.get(), &isAllLoaded]() {
+                if (!entity->Load())
+                {
+                    spdlog::error("LevelDescription::Analyze| Failed to load {} to analyze!", kind);
+                    isAllLoaded = false;
+                }
+            }, dependencies);
+        };
 
-        if (!m_context->Flags[IgnoreFlags::IgnoreTEX]) {
-            m_context->TEXInstance = GameEntityFactory::Create<TEX>(m_context->Assets.TEX, m_context);
-            if (!m_context->TEXInstance->Load()) {
-                spdlog::error("LevelDescription::Analyze| Failed to load TEX to analyze!");
-            }
-        } else spdlog::info(" * TEX ignored by user");
+        addEntityLoadTask("LOC", IgnoreFlags::IgnoreLOC, m_context->Assets.LOC, m_context->LOCInstance, {});
+        addEntityLoadTask("PRP", IgnoreFlags::IgnorePRP, m_context->Assets.PRP, m_context->PRPInstance, {});
+        addEntityLoadTask("ANM", IgnoreFlags::IgnoreANM, m_context->Assets.ANM, m_context->ANMInstance, {});
+        addEntityLoadTask("SND", IgnoreFlags::IgnoreSND, m_context->Assets.SND, m_context->SNDInstance, {});
+        addEntityLoadTask("TEX", IgnoreFlags::IgnoreTEX, m_context->Assets.TEX, m_context->TEXInstance, {});
 
-        if (!m_context->Flags[IgnoreFlags::IgnorePRM]) {
-            m_context->PRMInstance = GameEntityFactory::Create<PRM>(m_context->Assets.PRM, m_context);
-            if (!m_context->PRMInstance->Load()) {
-                spdlog::error("LevelDescription::Analyze| Failed to load PRM to analyze!");
-            }
-        } else spdlog::info(" * PRM ignored by user");
+        addEntityLoadTask("PRM", IgnoreFlags::IgnorePRM, m_context->Assets.PRM, m_context->PRMInstance, {});
 
-        if (!m_context->Flags[IgnoreFlags::IgnoreGMS]) {
-            m_context->GMSInstance = GameEntityFactory::Create<GMS>(m_context->Assets.GMS, m_context);
-            if (!m_context->GMSInstance->Load()) {
-                spdlog::error("LevelDescription::Analyze| Failed to load GMS to analyze!");
-            }
-        } else spdlog::info(" * GMS ignored by user");
+        if (!m_context->Flags[IgnoreFlags::IgnoreGMS] && !m_context->Assets.BUF.empty())
+        {
+            const auto bufTask = graph.AddTask("BUF prefetch", prefetch(m_context->Assets.BUF));
+            addEntityLoadTask("GMS", IgnoreFlags::IgnoreGMS, m_context->Assets.GMS, m_context->GMSInstance, { bufTask });
+        }
+        else
+        {
+            addEntityLoadTask("GMS", IgnoreFlags::IgnoreGMS, m_context->Assets.GMS, m_context->GMSInstance, {});
+        }
+
+        // Calling thread waits for the graph, so workers count could be reduced to 0 (inline execution)
+        ThreadPool pool { m_context->WorkersCount > 1 ? m_context->WorkersCount : 0 };
+        graph.Run(pool);
+
+        return isAllLoaded;
     }
 
-    void LevelDescription::PrintInfo()
+    void LevelDescription::PrintInfo(spdlog::logger& report)
     {
         if (m_context)
         {
-            if (m_context->ANMInstance) m_context->ANMInstance->PrintInfo();
-            if (m_context->GMSInstance) m_context->GMSInstance->PrintInfo();
-            if (m_context->PRMInstance) m_context->PRMInstance->PrintInfo();
-            if (m_context->PRPInstance) m_context->PRPInstance->PrintInfo();
-            if (m_context->TEXInstance) m_context->TEXInstance->PrintInfo();
-            if (m_context->SNDInstance) m_context->SNDInstance->PrintInfo();
-            if (m_context->LOCInstance) m_context->LOCInstance->PrintInfo();
+            if (m_context->ANMInstance) m_context->ANMInstance->PrintInfo(report);
+            if (m_context->GMSInstance) m_context->GMSInstance->PrintInfo(report);
+            if (m_context->PRMInstance) m_context->PRMInstance->PrintInfo(report);
+            if (m_context->PRPInstance) m_context->PRPInstance->PrintInfo(report);
+            if (m_context->TEXInstance) m_context->TEXInstance->PrintInfo(report);
+            if (m_context->SNDInstance) m_context->SNDInstance->PrintInfo(report);
+            if (m_context->LOCInstance) m_context->LOCInstance->PrintInfo(report);
         }
     }
 
+    void LevelDescription::WriteReport(IReportWriter& writer, bool loaded)
+    {
+        if (!m_context)
+        {
+            return;
+        }
+
+        writer.BeginRecord("level");
+        writer.WriteString("path", m_context->ArchivePath);
+        writer.WriteBool("main", IsMain());
+        writer.WriteBool("loaded", loaded);
+        writer.EndRecord();
+
+        if (m_context->ANMInstance) m_context->ANMInstance->WriteReport(writer);
+        if (m_context->GMSInstance) m_context->GMSInstance->WriteReport(writer);
+        if (m_context->PRMInstance) m_context->PRMInstance->WriteReport(writer);
+        if (m_context->PRPInstance) m_context->PRPInstance->WriteReport(writer);
+        if (m_context->TEXInstance) m_context->TEXInstance->WriteReport(writer);
+        if (m_context->SNDInstance) m_context->SNDInstance->WriteReport(writer);
+        if (m_context->LOCInstance) m_context->LOCInstance->WriteReport(writer);
+    }
+
     void LevelDescription::ExportUncompressedGMS(const std::string& path)
     {
         if (!m_context)
@@ -248,6 +298,11 @@ namespace ReGlacier
 
         SGMSHeader_t header { 0 };
         auto buffer = m_context->GMSInstance->GetUncompressedBuffer(header.iUncompressedSize);
+        if (!buffer)
+        {
+            spdlog::error("LevelDescription::GenerateGMSUncompressedBody| Failed to get uncompressed GMS body");
+            return false;
+        }
         header.iBufferSize = header.iUncompressedSize;
         header.bIsUncompressed = true;
 
@@ -264,6 +319,92 @@ namespace ReGlacier
         return true;
     }
 
+    static bool WriteExtractedFile(const std::filesystem::path& outputDirectory, std::string_view path, std::span<const uint8_t> contents)
+    {
+        // Don't let broken archives write outside of the output directory
+        const auto relativePath = std::filesystem::path(path).lexically_normal();
+        if (relativePath.empty() || relativePath.is_absolute() || relativePath.has_root_name() || *relativePath.begin() == "..")
+        {
+            spdlog::warn("LevelDescription::Extract| Skip file with unsafe path {}", path);
+            return false;
+        }
+
+        std::error_code errorCode;
+        const auto outputPath = outputDirectory / relativePath;
+        if (path.ends_with('/'))
+        {
+            std::filesystem::create_directories(outputPath, errorCode);
+            return true;
+        }
+
+        std::filesystem::create_directories(outputPath.parent_path(), errorCode);
+
+        std::ofstream stream(outputPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+
+        if (!stream)
+        {
+            spdlog::error("LevelDescription::Extract| Failed to write file {}", outputPath.string());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool LevelDescription::ExtractAllFiles(std::string_view directory)
+    {
+        if (!m_context || !m_context->Container)
+        {
+            spdlog::error("LevelDescription::ExtractAllFiles| Level is not opened");
+            return false;
+        }
+
+        const std::filesystem::path outputDirectory { directory };
+        size_t totalExtracted = 0;
+        size_t totalFailed = 0;
+
+        const bool isAllRead = m_context->Container->ForEachEntry([&](std::string_view path, const LevelContainer::Entry&, std::span<const uint8_t> contents) {
+            if (WriteExtractedFile(outputDirectory, path, contents))
+                ++totalExtracted;
+            else
+                ++totalFailed;
+
+            return true;
+        });
+
+        spdlog::info("LevelDescription::ExtractAllFiles| Extracted {} files into {} (failed: {})", totalExtracted, directory, totalFailed);
+        return isAllRead && totalFailed == 0;
+    }
+
+    bool LevelDescription::ExtractAssets(std::string_view directory)
+    {
+        if (!m_context || !m_context->Container)
+        {
+            spdlog::error("LevelDescription::ExtractAssets| Level is not opened");
+            return false;
+        }
+
+        const std::filesystem::path outputDirectory { directory };
+        const auto paths = m_context->Assets.GetResolvedPaths();
+
+        ThreadPool pool { m_context->WorkersCount > 1 ? m_context->WorkersCount : 0 };
+        const auto results = m_context->Container->ReadMany(paths, pool);
+
+        size_t totalFailed = 0;
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            const auto& result = results[i];
+            if (!result.Buffer || !WriteExtractedFile(outputDirectory, paths[i], { result.Buffer.get(), result.BufferSize }))
+            {
+                spdlog::error("LevelDescription::ExtractAssets| Failed to extract {}", paths[i]);
+                ++totalFailed;
+            }
+        }
+
+        spdlog::info("LevelDescription::ExtractAssets| Extracted {} assets into {} (failed: {})", paths.size() - totalFailed, directory, totalFailed);
+        return totalFailed == 0;
+    }
+
     void LevelDescription::SetIgnoreGMSFlag(bool flag) { m_context->Flags[IgnoreFlags::IgnoreGMS] = flag; }
     void LevelDescription::SetIgnoreANMFlag(bool flag) { m_context->Flags[IgnoreFlags::IgnoreANM] = flag; }
     void LevelDescription::SetIgnoreLOCFlag(bool flag) { m_context->Flags[IgnoreFlags::IgnoreLOC] = flag; }
@@ -271,56 +412,128 @@ namespace ReGlacier
     void LevelDescription::SetIgnorePRPFlag(bool flag) { m_context->Flags[IgnoreFlags::IgnorePRP] = flag; }
     void LevelDescription::SetIgnoreTEXFlag(bool flag) { m_context->Flags[IgnoreFlags::IgnoreTEX] = flag; }
     void LevelDescription::SetIgnoreSNDFlag(bool flag) { m_context->Flags[IgnoreFlags::IgnoreSND] = flag; }
+    void LevelDescription::SetWorkersCount(size_t workersCount) { m_context->WorkersCount = workersCount; }
+    void LevelDescription::SetParseDiagnostics(const ParseDiagnostics& diagnostics) { m_context->Diagnostics = diagnostics; }
+
+    void LevelDescription::ReleaseCachedBuffers()
+    {
+        if (!m_context) return;
+
+        m_context->ResetGeomIndex();
+        if (m_context->GMSInstance) m_context->GMSInstance->ReleaseUncompressedBuffer();
+        if (m_context->Container) m_context->Container->ClearCache();
+    }
+
+    const GMSGeomIndex* LevelDescription::GetGeomIndex() const
+    {
+        if (!m_context)
+        {
+            return nullptr;
+        }
+
+        std::call_once(*m_context->GeomIndexOnce, [this]() {
+            if (m_context->GMSInstance && m_context->GMSInstance->IsLoaded())
+            {
+                m_context->GeomIndex = std::make_unique<GMSGeomIndex>(m_context->GMSInstance.get());
+            }
+        });
+
+        return m_context->GeomIndex.get();
+    }
+
+    std::span<const uint32_t> LevelDescription::FindGeomsByType(uint32_t typeId) const
+    {
+        const auto index = GetGeomIndex();
+        return index ? index->FindByType(typeId) : std::span<const uint32_t> {};
+    }
+
+    std::vector<uint32_t> LevelDescription::FindGeomsByTypeName(std::string_view typeName) const
+    {
+        const auto index = GetGeomIndex();
+        if (!index)
+        {
+            return {};
+        }
+
+        // Only a few distinct types are used by the level, so names are compared for them instead of keeping name -> id map of all types
+        const auto& typesDataBase = TypesDataBase::GetInstance();
+
+        std::vector<uint32_t> result;
+        for (const auto typeId : index->GetTypeIds())
+        {
+            const auto type = typesDataBase.FindType(typeId);
+            if (type && type->Name == typeName)
+            {
+                const auto geoms = index->FindByType(typeId);
+                result.insert(result.end(), geoms.begin(), geoms.end());
+            }
+        }
+
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    std::span<const uint32_t> LevelDescription::FindGeomsByNamePrefix(std::string_view prefix) const
+    {
+        const auto index = GetGeomIndex();
+        return index ? index->FindByNamePrefix(prefix) : std::span<const uint32_t> {};
+    }
+
+    std::span<const uint32_t> LevelDescription::FindGeomsByPRMOffset(uint32_t prmOffset) const
+    {
+        const auto index = GetGeomIndex();
+        return index ? index->FindByPRMOffset(prmOffset) : std::span<const uint32_t> {};
+    }
+
+    std::optional<GMSGeomInfo> LevelDescription::GetGeomInfo(uint32_t geomIndex) const
+    {
+        if (!m_context || !m_context->GMSInstance)
+        {
+            return std::nullopt;
+        }
+
+        return m_context->GMSInstance->GetGeomInfo(geomIndex);
+    }
 
     bool LevelDescription::ValidateLevelArchive()
     {
-        if (!m_context || !m_context->Zip)
+        if (!m_context || !m_context->Container)
         {
             spdlog::error("Level validation failed! Wrong call");
             return false;
         }
 
-        int ret = unzGoToFirstFile(m_context->Zip);
-        if (ret != UNZ_OK)
+        // Walk over the central directory only once, all next reads will seek by the index
+        if (!m_context->Container->BuildIndex())
         {
-            spdlog::error("ValidateLevelArchive| unzGoToFirstFile() failed with code {}", ret);
+            spdlog::error("ValidateLevelArchive| Failed to build index of level archive {}", m_context->ArchivePath);
             return false;
         }
 
         // We need to locate folder
         bool allAssetsExplored = false;
 
-        do {
-            static constexpr int kMaxFileNameLength = 256;
-            char fileName[kMaxFileNameLength] = { 0 };
-            unz_file_info fileInfo;
-
-            ret = unzGetCurrentFileInfo(m_context->Zip, &fileInfo, fileName, kMaxFileNameLength, nullptr, 0, nullptr, 0);
-            if (ret != UNZ_OK)
-            {
-                spdlog::error("unzGetCurrentFileInfo() failed with error code {}", ret);
-                return false;
-            }
-
-            std::string name { fileName };
+        for (const auto& name : m_context->Container->GetEntryNames())
+        {
             m_context->Assets.TryResolve(name);
 
             // Check
             allAssetsExplored = m_context->Assets.AllResolved();
-
-            if (!allAssetsExplored && unzGoToNextFile(m_context->Zip) != UNZ_OK)
+            if (allAssetsExplored)
             {
-                spdlog::warn("No more files to analyze. End of archive {}", m_context->ArchivePath);
                 break;
             }
-        } while (!allAssetsExplored);
+        }
 
         if (allAssetsExplored)
         {
             spdlog::info("Level structure resolved!");
         }
+        else
+        {
+            spdlog::warn("No more files to analyze. End of archive {}", m_context->ArchivePath);
+        }
 
-        unzGoToFirstFile(m_context->Zip);
         return true;
     }
 }
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include <MappedFile.h>
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <Windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace ReGlacier
+{
+    MappedFile::MappedFile(std::string path) : m_path(std::move(path))
+    {}
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    bool MappedFile::Open()
+    {
+        Close();
+
+#ifdef _WIN32
+        HANDLE fileHandle = CreateFileA(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            spdlog::error("MappedFile::Open| Failed to open file {}. Error code {}", m_path, GetLastError());
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            spdlog::error("MappedFile::Open| File {} is empty or size is unavailable", m_path);
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mappingHandle)
+        {
+            spdlog::error("MappedFile::Open| CreateFileMapping() failed for file {}. Error code {}", m_path, GetLastError());
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            spdlog::error("MappedFile::Open| MapViewOfFile() failed for file {}. Error code {}", m_path, GetLastError());
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        m_fileHandle = fileHandle;
+        m_mappingHandle = mappingHandle;
+        m_data = static_cast<const uint8_t*>(view);
+        m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int fileDescriptor = open(m_path.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+        {
+            spdlog::error("MappedFile::Open| Failed to open file {}", m_path);
+            return false;
+        }
+
+        struct stat fileStat {};
+        if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            spdlog::error("MappedFile::Open| File {} is empty or size is unavailable", m_path);
+            close(fileDescriptor);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (view == MAP_FAILED)
+        {
+            spdlog::error("MappedFile::Open| mmap() failed for file {}", m_path);
+            close(fileDescriptor);
+            return false;
+        }
+
+        m_fileDescriptor = fileDescriptor;
+        m_data = static_cast<const uint8_t*>(view);
+        m_size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+        return true;
+    }
+
+    bool MappedFile::IsOpened() const
+    {
+        return m_data != nullptr;
+    }
+
+    const uint8_t* MappedFile::GetData() const
+    {
+        return m_data;
+    }
+
+    size_t MappedFile::GetSize() const
+    {
+        return m_size;
+    }
+
+    std::span<const uint8_t> MappedFile::GetRange(size_t offset, size_t size) const
+    {
+        if (!m_data || offset > m_size || size > m_size - offset)
+        {
+            return {};
+        }
+
+        return { m_data + offset, size };
+    }
+
+    void MappedFile::Close()
+    {
+#ifdef _WIN32
+        if (m_data)
+        {
+            UnmapViewOfFile(m_data);
+        }
+
+        if (m_mappingHandle)
+        {
+            CloseHandle(m_mappingHandle);
+        }
+
+        if (m_fileHandle)
+        {
+            CloseHandle(m_fileHandle);
+        }
+
+        m_mappingHandle = nullptr;
+        m_fileHandle = nullptr;
+#else
+        if (m_data)
+        {
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+
+        if (m_fileDescriptor >= 0)
+        {
+            close(m_fileDescriptor);
+        }
+
+        m_fileDescriptor = -1;
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
@@ -7,7 +7,7 @@
 #include <GlacierTypeDefs.h>
 #include <TypesDataBase.h>
 
-#include <BinaryWalker.h>
+#include <BasicBinaryWalker.h>
 #include <BinaryWalkerADL.h>
 
 #include <spdlog/spdlog.h>
@@ -35,7 +35,7 @@ namespace ReGlacier
         return true; //Skip for speed
 
         size_t prmBufferSize = 0;
-        auto prmBuffer = m_container->Read(m_name, prmBufferSize);
+        auto prmBuffer = m_container->ReadShared(m_name, prmBufferSize);
 
         if (!prmBuffer)
         {
@@ -43,7 +43,7 @@ namespace ReGlacier
             return false;
         }
 
-        BinaryWalker binaryWalker(prmBuffer.get(), prmBufferSize);
+        BinaryReader binaryWalker(prmBuffer.get(), prmBufferSize);
 
         PRMHeader header {};
         PRMChunk chunk {};
@@ -52,7 +52,7 @@ namespace ReGlacier
         BinaryWalkerADL<PRMHeader>::Read(binaryWalker, header);
 
         // Read root chunk
-        binaryWalker.Seek(header.ChunkPos, BinaryWalker::SeekType::FROM_BEGIN);
+        binaryWalker.Seek(header.ChunkPos, BinaryReader::BEGIN);
 
         spdlog::info("Total chunks: {}, first chunk at +{:X}", header.ChunkNum, header.ChunkPos);
         spdlog::info("  #   |    Pos   |   Size   |  Is GEOM  |  Unknown ");
@@ -6,253 +6,428 @@
 #include <GlacierTypeDefs.h>
 #include <TypesDataBase.h>
 
-#include <BinaryWalker.h>
+#include <BasicBinaryWalker.h>
 #include <BinaryWalkerADL.h>
+#include <StreamWalker.h>
+
+#include <Report/IReportWriter.h>
 
 #include <spdlog/spdlog.h>
 
+#include <bit>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include <fstream>
 #include <algorithm>
 #include <optional>
 
 namespace ReGlacier
 {
-    static constexpr const char* kNoTag = "(NOT A TAG)";
     static constexpr const char* kExpectedIdentifier = "IOPacked v0.1";
 
     static constexpr int kKeysOffset = 0x17;
     static constexpr int kKeysListOffset = 0x1F;
 
+    static constexpr size_t kAverageTagSize = 4; ///< Bytes of values per tag used to guess tokens count
+    static constexpr size_t kMaxReservedTokens = PRPTokenStream::kDefaultExpectedTokens * 4;
+
     PRP_ETag PRP_ETag_Helpers::FromByte(uint8_t byte)
     {
-        if (byte < PRP_ETag::TAG_Array || byte > PRP_ETag::TAG_NameBitfield)
-        {
-            return PRP_ETag::NO_TAG;
-        }
-
-        if (byte == 14 || byte == 128 || byte == 142 || (byte >= 16 && byte <= 123))
-        {
-            return PRP_ETag::TAG_UNKNOWN;
-        }
-
-        return static_cast<PRP_ETag>(byte);
+        return kPRPTagInfo[byte].Tag;
     }
 
     std::string_view PRP_ETag_Helpers::ToString(PRP_ETag tag)
     {
-#define RETAG(id) if (tag == (id)) { return #id; }
-        RETAG(PRP_ETag::TAG_Array);
-        RETAG(PRP_ETag::TAG_BeginObject);
-        RETAG(PRP_ETag::TAG_Reference);
-        RETAG(PRP_ETag::TAG_Container);
-        RETAG(PRP_ETag::TAG_Char);
-        RETAG(PRP_ETag::TAG_Bool);
-        RETAG(PRP_ETag::TAG_Int8);
-        RETAG(PRP_ETag::TAG_Int16);
-        RETAG(PRP_ETag::TAG_Int32);
-        RETAG(PRP_ETag::TAG_Float32);
-        RETAG(PRP_ETag::TAG_Float64);
-        RETAG(PRP_ETag::TAG_String);
-        RETAG(PRP_ETag::TAG_RawData);
-        RETAG(PRP_ETag::TAG_Bitfield);
-        RETAG(PRP_ETag::TAG_EndArray);
-        RETAG(PRP_ETag::TAG_SkipMark);
-        RETAG(PRP_ETag::TAG_EndObject);
-        RETAG(PRP_ETag::TAG_EndOfStream);
-        RETAG(PRP_ETag::TAG_NamedArray);
-        RETAG(PRP_ETag::TAG_BeginNamedObject);
-        RETAG(PRP_ETag::TAG_NamedReference);
-        RETAG(PRP_ETag::TAG_NamedContainer);
-        RETAG(PRP_ETag::TAG_NamedChar);
-        RETAG(PRP_ETag::TAG_NamedBool);
-        RETAG(PRP_ETag::TAG_NamedInt8);
-        RETAG(PRP_ETag::TAG_NamedInt16);
-        RETAG(PRP_ETag::TAG_NamedInt32);
-        RETAG(PRP_ETag::TAG_NamedFloat32);
-        RETAG(PRP_ETag::TAG_NamedFloat64);
-        RETAG(PRP_ETag::TAG_NamedString);
-        RETAG(PRP_ETag::TAG_NamedRawData);
-        RETAG(PRP_ETag::TAG_NameBitfield);
-        RETAG(PRP_ETag::TAG_UNKNOWN);
-        return kNoTag;
-#undef RETAG
+        return kPRPTagInfo[tag].Name;
     }
 
     bool PRP_ETag_Helpers::IsTagIncreaseDepthLevel(PRP_ETag tag)
     {
-        return
-            tag == PRP_ETag::TAG_Array || tag == PRP_ETag::TAG_BeginObject ||
-            tag == PRP_ETag::TAG_Container || tag == PRP_ETag::TAG_NamedContainer ||
-            tag == PRP_ETag::TAG_BeginNamedObject || tag == PRP_ETag::TAG_NamedArray;
+        return kPRPTagInfo[tag].DepthDelta > 0;
     }
 
     bool PRP_ETag_Helpers::IsTagDecreateDepthLevel(PRP_ETag tag)
     {
-        return tag == PRP_ETag::TAG_EndArray || tag == PRP_ETag::TAG_EndObject || tag == PRP_ETag::TAG_EndOfStream;
+        return kPRPTagInfo[tag].DepthDelta < 0;
+    }
+
+    static std::string FormatDataBlock(const PRPDataBlock& value)
+    {
+        return std::visit([](const auto& data) -> std::string {
+            using T = std::decay_t<decltype(data)>;
+
+            if constexpr (std::is_same_v<T, std::monostate>)
+                return "?";
+            else if constexpr (std::is_same_v<T, std::string_view>)
+                return fmt::format("\"{}\"", data);
+            else if constexpr (std::is_same_v<T, std::span<const uint8_t>>)
+                return fmt::format("<{} bytes>", data.size());
+            else if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t>)
+                return fmt::format("{} (hex 0x{:08X})", data, static_cast<uint32_t>(data));
+            else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, int8_t>)
+                return fmt::format("{}", static_cast<int>(data));
+            else
+                return fmt::format("{}", data);
+        }, value);
     }
 
     PRP::PRP(std::string name, LevelContainer* levelContainer, LevelAssets* levelAssets)
         : IGameEntity(name, levelContainer, levelAssets)
     {}
 
-    PRP::~PRP()
-    {
-        delete m_tree;
-        m_tree = nullptr;
-    }
+    PRP::~PRP() = default;
 
     bool PRP::Load()
     {
-        size_t prpBufferSize = 0;
-        auto prpBuffer = m_container->Read(m_name, prpBufferSize);
-        if (!prpBuffer)
+        // PRP is parsed forward only, so it's not required to inflate it before parsing
+        StreamWalker binaryWalker { m_container->OpenStream(m_name) };
+        if (!binaryWalker)
         {
             spdlog::error("PRP::Load| Failed to load asset {}", m_name);
             return false;
         }
 
-        BinaryWalker binaryWalker { prpBuffer.get(), prpBufferSize };
+        const size_t prpBufferSize = binaryWalker.GetSize();
 
+        try
         {
-            std::string headerStr = binaryWalker.ReadZString(strlen(kExpectedIdentifier));
+            {
+                std::string headerStr = binaryWalker.ReadZString(strlen(kExpectedIdentifier));
+
+                if (std::string_view(headerStr) != std::string_view(kExpectedIdentifier))
+                {
+                    spdlog::error("PRP::Load| Failed to load PRP {}. Reason: bad header!", m_name);
+                    return false;
+                }
+
+                spdlog::debug("PRP::Load| Header is OK");
+                binaryWalker.Seek(kKeysOffset, IBaseStreamWalker::BEGIN);
+            }
 
-            if (std::string_view(headerStr) != std::string_view(kExpectedIdentifier))
             {
-                spdlog::error("PRP::Load| Failed to load PRP {}. Reason: bad header!", m_name);
-                return false;
+                m_keysCount = binaryWalker.ReadUInt32();
+                m_valuesOffset = binaryWalker.ReadUInt32();
+
+                if (m_valuesOffset < 0 || static_cast<size_t>(m_valuesOffset) > prpBufferSize - binaryWalker.GetPosition())
+                {
+                    spdlog::error("PRP::Load| Failed to load PRP {}. Reason: Bad 'values' offset!", m_name);
+                    m_keysCount = 0;
+                    m_valuesOffset = 0;
+                    return false;
+                }
+
+                // Each key takes at least 2 bytes of the keys table (empty strings are skipped)
+                if (m_keysCount < 0 || m_keysCount > m_valuesOffset / 2)
+                {
+                    spdlog::error("PRP::Load| Failed to load PRP {}. Reason: Bad keys count {}!", m_name, m_keysCount);
+                    m_keysCount = 0;
+                    m_valuesOffset = 0;
+                    return false;
+                }
             }
 
-            spdlog::info("PRP::Load| Header is OK");
-            binaryWalker.Seek(kKeysOffset, IBaseStreamWalker::BEGIN);
-        }
+            spdlog::debug("PRP::Load| Header looks OK.");
+            spdlog::debug("PRP::Load| Total keys: {}", m_keysCount);
 
-        {
-            m_keysCount = binaryWalker.ReadUInt32();
-            m_valuesOffset = binaryWalker.ReadUInt32();
+            m_keys.clear();
+            m_keys.reserve(m_keysCount);
+
+            // Keys table is placed right before values, so take it at once and refer to keys by view
+            m_keysPool = std::make_unique<char[]>(m_valuesOffset);
+            binaryWalker.ReadArray(m_keysPool.get(), m_valuesOffset);
 
-            if (m_valuesOffset >= prpBufferSize)
+            BinaryReader keysWalker { reinterpret_cast<const uint8_t*>(m_keysPool.get()), static_cast<size_t>(m_valuesOffset) };
+            while (m_keys.size() != m_keysCount)
             {
-                spdlog::error("PRP::Load| Failed to load PRP {}. Reason: Bad 'values' offset!", m_name);
-                m_keysCount = 0;
-                m_valuesOffset = 0;
-                return false;
+                auto val = keysWalker.ReadZStringView();
+                if (!val.empty())
+                {
+                    m_keys.push_back(val);
+                }
             }
         }
+        catch (const std::exception& exception)
+        {
+            spdlog::error("PRP::Load| Failed to load keys of PRP {}. Reason: {}", m_name, exception.what());
+            m_keysCount = static_cast<int>(m_keys.size());
+            return false;
+        }
 
-        spdlog::info("PRP::Load| Header looks OK.");
-        spdlog::info("PRP::Load| Total keys: {}", m_keysCount);
-
-        m_keys.clear();
-        m_keys.reserve(m_keysCount);
-
-        while (m_keys.size() != m_keysCount)
+        // Decompile it (level of diagnostics is resolved once, so disabled diagnostics cost nothing inside of the loop)
+        try
         {
-            std::string val = binaryWalker.ReadZString();
-            if (!val.empty())
+            switch (m_diagnostics.Level)
             {
-                m_keys.push_back(val);
+                case ParseDiagnosticsLevel::Off:     TryToDecompileEntities<ParseDiagnosticsLevel::Off>(binaryWalker); break;
+                case ParseDiagnosticsLevel::Summary: TryToDecompileEntities<ParseDiagnosticsLevel::Summary>(binaryWalker); break;
+                case ParseDiagnosticsLevel::Trace:   TryToDecompileEntities<ParseDiagnosticsLevel::Trace>(binaryWalker); break;
             }
         }
-
-        // Decompile it
-        TryToDecompileEntities(std::move(prpBuffer), prpBufferSize);
+        catch (const std::exception& exception)
+        {
+            spdlog::error("PRP::Load| Failed to decompile entities of PRP {}. Reason: {}", m_name, exception.what());
+            return false;
+        }
 
         return true;
     }
 
-    void PRP::PrintInfo()
+    void PRP::PrintInfo(spdlog::logger& report)
     {
-        spdlog::info("PRP Info: ");
-        spdlog::info("Keys: {}", m_keysCount);
+        report.info("PRP Info: ");
+        report.info("Keys: {}", m_keysCount);
         int index = 0;
         for (index = 0; index < m_keysCount; index++)
         {
-            spdlog::info(" [{}] = {}", index, m_keys[index]);
+            report.info(" [{}] = {}", index, m_keys[index]);
+        }
+
+        if (m_parseStats)
+        {
+            const auto& stats = m_parseStats.value();
+
+            report.info("Values: {} tags, {} bytes, max depth {}, not recognized {} bytes", stats.TotalTags, stats.TotalBytes, stats.MaxDepth, stats.SkippedBytes);
+            for (size_t byte = 0; byte < stats.TagsCount.size(); byte++)
+            {
+                if (stats.TagsCount[byte])
+                {
+                    report.info(" {:40} {}", PRP_ETag_Helpers::GetInfo(static_cast<uint8_t>(byte)).Name, stats.TagsCount[byte]);
+                }
+            }
+        }
+
+        report.info(" --- END OF PRP --- ");
+    }
+
+    void PRP::WriteReport(IReportWriter& writer)
+    {
+        writer.BeginRecord("prp");
+        writer.WriteInt("keys", m_keysCount);
+        writer.EndRecord();
+
+        for (int index = 0; index < m_keysCount; index++)
+        {
+            writer.BeginRecord("prp.key");
+            writer.WriteInt("index", index);
+            writer.WriteString("name", m_keys[index]);
+            writer.EndRecord();
+        }
+
+        if (m_parseStats)
+        {
+            const auto& stats = m_parseStats.value();
+
+            writer.BeginRecord("prp.stats");
+            writer.WriteUInt("tags", stats.TotalTags);
+            writer.WriteUInt("bytes", stats.TotalBytes);
+            writer.WriteUInt("max_depth", stats.MaxDepth);
+            writer.WriteUInt("skipped_bytes", stats.SkippedBytes);
+            writer.EndRecord();
+
+            for (size_t byte = 0; byte < stats.TagsCount.size(); byte++)
+            {
+                if (stats.TagsCount[byte])
+                {
+                    writer.BeginRecord("prp.tag_count");
+                    writer.WriteString("tag", PRP_ETag_Helpers::GetInfo(static_cast<uint8_t>(byte)).Name);
+                    writer.WriteUInt("count", stats.TagsCount[byte]);
+                    writer.EndRecord();
+                }
+            }
         }
-        spdlog::info(" --- END OF PRP --- ");
     }
 
-    void PRP::TryToDecompileEntities(std::unique_ptr<uint8_t[]>&& buffer, size_t bufferSize)
+    template <ParseDiagnosticsLevel Level, typename TWalker>
+    void PRP::TryToDecompileEntities(TWalker& binaryWalker)
     {
-        BinaryWalker binaryWalker { buffer.get(), bufferSize };
+        static constexpr bool kCollectStats = Level != ParseDiagnosticsLevel::Off;
+        static constexpr bool kTrace = Level == ParseDiagnosticsLevel::Trace;
+
         binaryWalker.Seek(kKeysListOffset, IBaseStreamWalker::BEGIN);
         binaryWalker.Seek(m_valuesOffset, IBaseStreamWalker::CURR);
-        spdlog::info("Current pos: {}", binaryWalker.GetPosition());
 
-        // Iterate over bytes, try to find TAG, if tag occured - decompress it's data if we can
-        PRP_ETag tag = PRP_ETag::NO_TAG;
-        int tagId = 0;
+        const size_t valuesBegin = binaryWalker.GetPosition();
 
-        if (m_tree)
+        // Most of tags are followed by 4 bytes or more of payload, so reserve is a guess (stream grows when it's not enough)
+        const size_t valuesSize = binaryWalker.GetSize() - valuesBegin;
+        m_tokens = std::make_unique<PRPTokenStream>(std::min(valuesSize / kAverageTagSize, kMaxReservedTokens));
+        m_parseStats.reset();
+
+        [[maybe_unused]] std::conditional_t<kCollectStats, ParseStats, std::monostate> stats {};
+        [[maybe_unused]] spdlog::logger* trace = nullptr;
+        [[maybe_unused]] size_t tagId = 0;
+
+        if constexpr (kTrace)
         {
-            delete m_tree;
-            m_tree = nullptr;
+            trace = m_diagnostics.TraceLogger ? m_diagnostics.TraceLogger.get() : spdlog::default_logger_raw();
+            trace->info("PRP {}: values at +{:X}", m_name, valuesBegin);
         }
 
-        m_tree = new PRPTreeNode(nullptr, PRP_ETag::NO_TAG); // No tag at root
-        auto currentNode = m_tree;
+        // Decode tag by tag: payload of each tag is consumed completely, so it will never be taken as the next tag
+        PRP_ETag tag = PRP_ETag::NO_TAG;
+        size_t totalSkippedBytes = 0;
 
         do
         {
-            auto pos = binaryWalker.GetPosition();
-            uint8_t byte = binaryWalker.ReadUInt8();
-            tag = PRP_ETag_Helpers::FromByte(byte);
+            const auto pos = binaryWalker.GetPosition();
+            const auto& info = PRP_ETag_Helpers::GetInfo(binaryWalker.ReadUInt8());
+            tag = info.Tag;
 
-            if (tag == PRP_ETag::NO_TAG) continue;
-            const auto tagName = PRP_ETag_Helpers::ToString(tag);
+            if (tag == PRP_ETag::NO_TAG || tag == PRP_ETag::TAG_UNKNOWN)
+            {
+                // Payload size is unknown, look for the next valid tag byte by byte
+                if (!totalSkippedBytes)
+                {
+                    spdlog::warn("PRP::TryToDecompileEntities| Unknown tag at +{:X} in {}. Stream will be resynchronized", pos, m_name);
+                }
 
-            // Recognize tag flags
-            if (PRP_ETag_Helpers::IsTagIncreaseDepthLevel(tag))
+                ++totalSkippedBytes;
+                continue;
+            }
+
+            const uint32_t nameIndex = info.IsNamed ? ReadKeyIndex(binaryWalker) : PRPTokenStream::kNoName;
+            const PRPDataBlock value = ReadPayload(binaryWalker, info);
+
+            if (info.DepthDelta > 0)
             {
-                // Allocate new depth level, insert as child, set current not to new depth controller
-                auto newChild = new PRPTreeNode(currentNode, tag);
-                currentNode->AddChild(newChild);
-                newChild->SetRefToBuffer(pos);
-                currentNode = newChild;
+                // New depth level: insert as child and make it current scope
+                m_tokens->OpenScope(m_tokens->Append(tag, pos, value, nameIndex));
             }
-            else if (PRP_ETag_Helpers::IsTagDecreateDepthLevel(tag))
+            else if (info.DepthDelta < 0)
             {
-                // Change depth level of tree - jump to parent node
-                if (!currentNode->IsRoot())
+                // Change depth level of tree - jump to parent scope
+                if (!m_tokens->IsAtRoot())
+                {
+                    m_tokens->Append(tag, pos, value, nameIndex);
+                    m_tokens->CloseScope();
+                }
+                else if (tag == PRP_ETag::TAG_EndOfStream)
                 {
-                    auto lastChild = new PRPTreeNode(currentNode, tag);
-                    lastChild->SetRefToBuffer(pos);
-                    currentNode->AddChild(lastChild);
-                    currentNode = currentNode->GetParent();
+                    m_tokens->Append(tag, pos, value, nameIndex);
                 }
                 else
                 {
-                    spdlog::warn(" *** TREE TRAVELING WARNING: TAG {} AT +{:X} TOLD US THAT WE NEED TO JUMP UP, BUT NO WAY TO DO THIS! *** ", PRP_ETag_Helpers::ToString(tag), pos);
+                    spdlog::warn(" *** TREE TRAVELING WARNING: TAG {} AT +{:X} TOLD US THAT WE NEED TO JUMP UP, BUT NO WAY TO DO THIS! *** ", info.Name, pos);
                 }
             }
             else
             {
                 // Normal tag, insert as child
-                auto child = new PRPTreeNode(currentNode, tag);
-                child->SetRefToBuffer(pos);
-                currentNode->AddChild(child);
+                m_tokens->Append(tag, pos, value, nameIndex);
             }
 
-            if (tag == PRP_ETag::TAG_Float32)
+            if constexpr (kCollectStats)
             {
-                auto fvl = binaryWalker.Read<float>();
-                spdlog::info("[{}] +{:X} {} = {}", tagId, pos, tagName, fvl);
+                ++stats.TagsCount[tag];
+                stats.MaxDepth = std::max(stats.MaxDepth, m_tokens->GetDepth());
             }
-            else if (tag == PRP_ETag::TAG_Int32)
+
+            if constexpr (kTrace)
             {
-                auto i32 = binaryWalker.Read<int32_t>();
-                spdlog::info("[{}] +{:X} {} = {} (hex 0x{:08X})", tagId, pos, tagName, i32, i32);
+                if (nameIndex != PRPTokenStream::kNoName)
+                    trace->info("[{}] +{:X} {} {} = {}", tagId, pos, info.Name, m_keys[nameIndex], FormatDataBlock(value));
+                else
+                    trace->info("[{}] +{:X} {} = {}", tagId, pos, info.Name, FormatDataBlock(value));
+
+                ++tagId;
             }
-            else
+        }
+        while (tag != PRP_ETag::TAG_EndOfStream);
+
+        if (totalSkippedBytes)
+        {
+            spdlog::warn("PRP::TryToDecompileEntities| {} bytes of {} were not recognized as tags", totalSkippedBytes, m_name);
+        }
+
+        if constexpr (kCollectStats)
+        {
+            stats.TotalTags = m_tokens->GetSize() - 1; // without root
+            stats.TotalBytes = binaryWalker.GetPosition() - valuesBegin;
+            stats.SkippedBytes = totalSkippedBytes;
+
+            spdlog::info("PRP::Load| {}: {} tags, {} keys, {} bytes, max depth {}", m_name, stats.TotalTags, m_keysCount, stats.TotalBytes, stats.MaxDepth);
+            m_parseStats = stats;
+        }
+    }
+
+    template <typename TWalker>
+    uint32_t PRP::ReadKeyIndex(TWalker& binaryWalker) const
+    {
+        const auto position = binaryWalker.GetPosition();
+        const uint32_t index = binaryWalker.ReadUInt32();
+
+        if (index >= m_keys.size())
+        {
+            throw std::runtime_error { fmt::format("Key index {} at +{:X} is out of keys table (total keys {})", index, position, m_keys.size()) };
+        }
+
+        return index;
+    }
+
+    template <typename TWalker>
+    PRPDataBlock PRP::ReadPayload(TWalker& binaryWalker, const PRP_TagInfo& info)
+    {
+        switch (info.Payload)
+        {
+            case PRP_EPayload::None:
+                return {};
+            case PRP_EPayload::Byte:
             {
-                spdlog::info("[{}] +{:X} {} = ?", tagId, pos, tagName);
+                const uint8_t byte = binaryWalker.ReadUInt8();
+                const auto unnamedTag = static_cast<uint8_t>(info.Tag & 0x7F);
+
+                if (unnamedTag == PRP_ETag::TAG_Bool) return byte != 0;
+                if (unnamedTag == PRP_ETag::TAG_Char) return static_cast<char>(byte);
+                return static_cast<int8_t>(byte);
             }
+            case PRP_EPayload::Int16:
+                return binaryWalker.ReadInt16();
+            case PRP_EPayload::Int32:
+                return binaryWalker.ReadInt32();
+            case PRP_EPayload::Float32:
+                return std::bit_cast<float>(binaryWalker.ReadUInt32());
+            case PRP_EPayload::Float64:
+            {
+                double value = 0.0;
+                binaryWalker.ReadArray(&value, 1);
+                return value;
+            }
+            case PRP_EPayload::Count:
+            case PRP_EPayload::Bitfield:
+                return binaryWalker.ReadUInt32();
+            case PRP_EPayload::String:
+            {
+                // Strings are stored in keys table, inline strings are used only by PRPs without it
+                if (!m_keys.empty())
+                {
+                    return m_keys[ReadKeyIndex(binaryWalker)];
+                }
 
-            ++tagId;
+                auto data = ReadInlineData(binaryWalker);
+                return std::string_view { reinterpret_cast<const char*>(data.data()), data.size() };
+            }
+            case PRP_EPayload::RawData:
+                return std::span<const uint8_t> { ReadInlineData(binaryWalker) };
+        }
+
+        return {};
+    }
+
+    template <typename TWalker>
+    std::span<uint8_t> PRP::ReadInlineData(TWalker& binaryWalker)
+    {
+        const auto position = binaryWalker.GetPosition();
+        const uint32_t size = binaryWalker.ReadUInt32();
+
+        if (size > binaryWalker.GetSize() - binaryWalker.GetPosition())
+        {
+            throw std::runtime_error { fmt::format("Data at +{:X} is out of file (size {})", position, size) };
         }
-        while (tag != PRP_ETag::TAG_EndOfStream);
 
-        spdlog::info("Total ETags: {}, Total Keys: {}", tagId + 1, m_keysCount);
+        auto data = m_tokens->AllocatePayload(size);
+        binaryWalker.ReadArray(data.data(), data.size());
+        return data;
     }
 }
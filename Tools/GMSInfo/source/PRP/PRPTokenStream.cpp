@@ -0,0 +1,98 @@
+#include <PRP/PRPTokenStream.h>
+
+#include <stdexcept>
+
+namespace ReGlacier
+{
+    PRPTokenStream::PRPTokenStream(size_t expectedTokens)
+    {
+        m_tokens.reserve(expectedTokens);
+
+        // No tag at root
+        m_tokens.push_back(Token { 0, kNoToken, kNoToken, kNoToken, kNoName, PRP_ETag::NO_TAG, {} });
+        m_scopes.push_back(Scope { kRootToken, kNoToken });
+    }
+
+    PRPTokenStream::Index PRPTokenStream::Append(PRP_ETag tag, size_t offset, PRPDataBlock value, uint32_t nameIndex)
+    {
+        if (m_tokens.size() >= kNoToken)
+        {
+            throw std::length_error { "Too many tokens in PRP stream" };
+        }
+
+        const auto index = static_cast<Index>(m_tokens.size());
+        Scope& scope = m_scopes.back();
+
+        m_tokens.push_back(Token { static_cast<uint32_t>(offset), scope.Owner, kNoToken, kNoToken, nameIndex, tag, value });
+
+        if (scope.LastChild != kNoToken)
+        {
+            m_tokens[scope.LastChild].NextSibling = index;
+        }
+        else
+        {
+            m_tokens[scope.Owner].FirstChild = index;
+        }
+
+        scope.LastChild = index;
+        return index;
+    }
+
+    void PRPTokenStream::OpenScope(Index token)
+    {
+        // Scope keeps own last child, so reopened token continues its list of children
+        Index lastChild = m_tokens.at(token).FirstChild;
+        while (lastChild != kNoToken && m_tokens[lastChild].NextSibling != kNoToken)
+        {
+            lastChild = m_tokens[lastChild].NextSibling;
+        }
+
+        m_scopes.push_back(Scope { token, lastChild });
+    }
+
+    bool PRPTokenStream::CloseScope()
+    {
+        if (IsAtRoot())
+        {
+            return false;
+        }
+
+        m_scopes.pop_back();
+        return true;
+    }
+
+    std::span<uint8_t> PRPTokenStream::AllocatePayload(size_t size)
+    {
+        if (!size)
+        {
+            return {};
+        }
+
+        return { static_cast<uint8_t*>(m_arena.allocate(size, 1)), size };
+    }
+
+    bool PRPTokenStream::IsAtRoot() const
+    {
+        return m_scopes.size() == 1;
+    }
+
+    size_t PRPTokenStream::GetDepth() const
+    {
+        return m_scopes.size() - 1;
+    }
+
+    size_t PRPTokenStream::GetSize() const
+    {
+        return m_tokens.size();
+    }
+
+    const PRPTokenStream::Token& PRPTokenStream::Get(Index index) const
+    {
+        return m_tokens[index];
+    }
+
+    std::span<const PRPTokenStream::Token> PRPTokenStream::GetTokens() const
+    {
+        return { m_tokens.data(), m_tokens.size() };
+    }
+}
@@ -0,0 +1,35 @@
+#include <ParseDiagnostics.h>
+
+#include <spdlog/spdlog.h>
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+namespace ReGlacier
+{
+    static constexpr const char* kTraceLoggerName = "parse_trace";
+
+    std::optional<ParseDiagnosticsLevel> ParseDiagnostics::LevelFromString(std::string_view name)
+    {
+        if (name == "off")     return ParseDiagnosticsLevel::Off;
+        if (name == "summary") return ParseDiagnosticsLevel::Summary;
+        if (name == "trace")   return ParseDiagnosticsLevel::Trace;
+        return std::nullopt;
+    }
+
+    std::shared_ptr<spdlog::logger> ParseDiagnostics::CreateTraceLogger(const std::string& path)
+    {
+        try
+        {
+            // Parser threads only put messages into the queue, formatting and file I/O are done by spdlog worker
+            auto logger = spdlog::basic_logger_mt<spdlog::async_factory>(kTraceLoggerName, path, true);
+            logger->set_pattern("%v");
+            logger->set_level(spdlog::level::trace); // Trace file is requested explicitly, --log-level does not apply
+            return logger;
+        }
+        catch (const spdlog::spdlog_ex& exception)
+        {
+            spdlog::error("ParseDiagnostics| Failed to create trace file {}: {}", path, exception.what());
+            return nullptr;
+        }
+    }
+}
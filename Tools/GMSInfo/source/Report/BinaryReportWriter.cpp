@@ -0,0 +1,119 @@
+#include <Report/BinaryReportWriter.h>
+
+#include <bit>
+
+namespace ReGlacier
+{
+    static constexpr size_t kMaxVarIntSize = 10;
+
+    bool BinaryReportWriter::Open(const std::string& path)
+    {
+        if (!m_output.Open(path))
+        {
+            return false;
+        }
+
+        const uint8_t header[] = {
+            static_cast<uint8_t>(kMagic), static_cast<uint8_t>(kMagic >> 8), static_cast<uint8_t>(kMagic >> 16), static_cast<uint8_t>(kMagic >> 24),
+            kVersion
+        };
+        m_output.Write(header, sizeof(header));
+
+        return true;
+    }
+
+    void BinaryReportWriter::BeginRecord(std::string_view type)
+    {
+        m_output.Put(static_cast<char>(kRecordBegin));
+        WriteName(type);
+    }
+
+    void BinaryReportWriter::EndRecord()
+    {
+        m_output.Put(static_cast<char>(kRecordEnd));
+    }
+
+    void BinaryReportWriter::WriteString(std::string_view key, std::string_view value)
+    {
+        m_output.Put(static_cast<char>(kString));
+        WriteName(key);
+        WriteVarInt(value.size());
+        m_output.Write(value);
+    }
+
+    void BinaryReportWriter::WriteInt(std::string_view key, int64_t value)
+    {
+        m_output.Put(static_cast<char>(kInt));
+        WriteName(key);
+        WriteVarInt((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)); // zigzag
+    }
+
+    void BinaryReportWriter::WriteUInt(std::string_view key, uint64_t value)
+    {
+        m_output.Put(static_cast<char>(kUInt));
+        WriteName(key);
+        WriteVarInt(value);
+    }
+
+    void BinaryReportWriter::WriteFloat(std::string_view key, double value)
+    {
+        m_output.Put(static_cast<char>(kFloat));
+        WriteName(key);
+
+        const auto bits = std::bit_cast<uint64_t>(value);
+        uint8_t bytes[sizeof(bits)];
+        for (size_t i = 0; i < sizeof(bits); i++)
+        {
+            bytes[i] = static_cast<uint8_t>(bits >> (i * 8));
+        }
+
+        m_output.Write(bytes, sizeof(bytes));
+    }
+
+    void BinaryReportWriter::WriteBool(std::string_view key, bool value)
+    {
+        m_output.Put(static_cast<char>(kBool));
+        WriteName(key);
+        m_output.Put(value ? 1 : 0);
+    }
+
+    bool BinaryReportWriter::Flush()
+    {
+        return m_output.Flush();
+    }
+
+    void BinaryReportWriter::WriteVarInt(uint64_t value)
+    {
+        uint8_t bytes[kMaxVarIntSize];
+        size_t size = 0;
+
+        do
+        {
+            bytes[size] = static_cast<uint8_t>(value & 0x7F);
+            value >>= 7;
+            if (value)
+            {
+                bytes[size] |= 0x80;
+            }
+            ++size;
+        } while (value);
+
+        m_output.Write(bytes, size);
+    }
+
+    void BinaryReportWriter::WriteName(std::string_view name)
+    {
+        if (auto it = m_names.find(name); it != m_names.end())
+        {
+            WriteVarInt(it->second);
+            return;
+        }
+
+        const auto id = static_cast<uint32_t>(m_names.size());
+        m_names.emplace(name, id);
+
+        WriteVarInt(id);
+        WriteVarInt(name.size());
+        m_output.Write(name);
+    }
+}
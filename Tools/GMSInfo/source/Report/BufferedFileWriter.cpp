@@ -0,0 +1,43 @@
+#include <Report/BufferedFileWriter.h>
+
+#include <spdlog/spdlog.h>
+
+namespace ReGlacier
+{
+    BufferedFileWriter::BufferedFileWriter(size_t bufferSize)
+        : m_bufferSize(bufferSize)
+    {
+        m_buffer.reserve(m_bufferSize);
+    }
+
+    BufferedFileWriter::~BufferedFileWriter()
+    {
+        Flush();
+    }
+
+    bool BufferedFileWriter::Open(const std::string& path)
+    {
+        m_stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        m_isOk = m_stream.good();
+
+        if (!m_isOk)
+        {
+            spdlog::error("BufferedFileWriter| Failed to open file {}", path);
+        }
+
+        return m_isOk;
+    }
+
+    bool BufferedFileWriter::Flush()
+    {
+        if (!m_buffer.empty() && m_stream.is_open())
+        {
+            m_stream.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+            m_stream.flush();
+            m_isOk = m_isOk && m_stream.good();
+        }
+
+        m_buffer.clear();
+        return m_isOk;
+    }
+}
@@ -0,0 +1,111 @@
+#include <Report/NDJsonReportWriter.h>
+
+#include <cmath>
+#include <iterator>
+
+#include <spdlog/fmt/fmt.h>
+
+namespace ReGlacier
+{
+    static constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+    bool NDJsonReportWriter::Open(const std::string& path)
+    {
+        return m_output.Open(path);
+    }
+
+    void NDJsonReportWriter::BeginRecord(std::string_view type)
+    {
+        m_output.Write(R"({"type":)");
+        WriteQuoted(type);
+    }
+
+    void NDJsonReportWriter::EndRecord()
+    {
+        m_output.Write("}\n");
+    }
+
+    void NDJsonReportWriter::WriteString(std::string_view key, std::string_view value)
+    {
+        WriteKey(key);
+        WriteQuoted(value);
+    }
+
+    void NDJsonReportWriter::WriteInt(std::string_view key, int64_t value)
+    {
+        WriteKey(key);
+        fmt::format_to(std::back_inserter(m_output.GetBuffer()), "{}", value);
+        m_output.FlushIfFull();
+    }
+
+    void NDJsonReportWriter::WriteUInt(std::string_view key, uint64_t value)
+    {
+        WriteKey(key);
+        fmt::format_to(std::back_inserter(m_output.GetBuffer()), "{}", value);
+        m_output.FlushIfFull();
+    }
+
+    void NDJsonReportWriter::WriteFloat(std::string_view key, double value)
+    {
+        WriteKey(key);
+
+        if (!std::isfinite(value))
+        {
+            m_output.Write("null"); // JSON has no NaN/Inf
+            return;
+        }
+
+        fmt::format_to(std::back_inserter(m_output.GetBuffer()), "{}", value);
+        m_output.FlushIfFull();
+    }
+
+    void NDJsonReportWriter::WriteBool(std::string_view key, bool value)
+    {
+        WriteKey(key);
+        m_output.Write(value ? "true" : "false");
+    }
+
+    bool NDJsonReportWriter::Flush()
+    {
+        return m_output.Flush();
+    }
+
+    void NDJsonReportWriter::WriteKey(std::string_view key)
+    {
+        m_output.Put(',');
+        WriteQuoted(key);
+        m_output.Put(':');
+    }
+
+    void NDJsonReportWriter::WriteQuoted(std::string_view value)
+    {
+        m_output.Put('"');
+
+        for (const char c : value)
+        {
+            const auto byte = static_cast<uint8_t>(c);
+
+            switch (c)
+            {
+                case '"':  m_output.Write(R"(\")"); break;
+                case '\\': m_output.Write(R"(\\)"); break;
+                case '\n': m_output.Write(R"(\n)"); break;
+                case '\r': m_output.Write(R"(\r)"); break;
+                case '\t': m_output.Write(R"(\t)"); break;
+                default:
+                    if (byte < 0x20 || byte > 0x7F)
+                    {
+                        const char escaped[] = { '\\', 'u', '0', '0', kHexDigits[byte >> 4], kHexDigits[byte & 0xF] };
+                        m_output.Write(escaped, sizeof(escaped));
+                    }
+                    else
+                    {
+                        m_output.Put(c);
+                    }
+                    break;
+            }
+        }
+
+        m_output.Put('"');
+    }
+}
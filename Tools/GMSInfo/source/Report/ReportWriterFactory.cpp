@@ -0,0 +1,54 @@
+#include <Report/ReportWriterFactory.h>
+#include <Report/NDJsonReportWriter.h>
+#include <Report/BinaryReportWriter.h>
+
+#include <spdlog/spdlog.h>
+
+namespace ReGlacier
+{
+    template <typename T>
+    static std::unique_ptr<IReportWriter> CreateAndOpen(const std::string& path)
+    {
+        auto writer = std::make_unique<T>();
+        if (!writer->Open(path))
+        {
+            return nullptr;
+        }
+
+        return writer;
+    }
+
+    std::optional<ReportFormat> ReportWriterFactory::FormatFromString(std::string_view name)
+    {
+        if (name == "text")   return ReportFormat::Text;
+        if (name == "ndjson") return ReportFormat::NDJson;
+        if (name == "binary") return ReportFormat::Binary;
+        return std::nullopt;
+    }
+
+    const char* ReportWriterFactory::GetFileExtension(ReportFormat format)
+    {
+        switch (format)
+        {
+            case ReportFormat::Text:   return ".txt";
+            case ReportFormat::NDJson: return ".ndjson";
+            case ReportFormat::Binary: return ".grpt";
+        }
+
+        return ".txt";
+    }
+
+    std::unique_ptr<IReportWriter> ReportWriterFactory::Create(ReportFormat format, const std::string& path)
+    {
+        switch (format)
+        {
+            case ReportFormat::NDJson: return CreateAndOpen<NDJsonReportWriter>(path);
+            case ReportFormat::Binary: return CreateAndOpen<BinaryReportWriter>(path);
+            case ReportFormat::Text:
+                spdlog::error("ReportWriterFactory| Text report is written by PrintInfo, there is no writer for it");
+                return nullptr;
+        }
+
+        return nullptr;
+    }
+}
@@ -0,0 +1,103 @@
+#include <StreamWalker.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ReGlacier
+{
+    StreamWalker::StreamWalker(LevelContainer::InflateStream::Ptr&& stream, size_t windowSize)
+        : IBaseStreamWalker(stream ? stream->GetSize() : 0, 0)
+        , m_stream(std::move(stream))
+        , m_window(windowSize)
+    {}
+
+    StreamWalker::operator bool() const
+    {
+        return m_stream != nullptr;
+    }
+
+    void StreamWalker::WriteUInt8(uint8_t)   { throw std::runtime_error { "Unable to write into stream" }; }
+    void StreamWalker::WriteInt8(int8_t)     { throw std::runtime_error { "Unable to write into stream" }; }
+    void StreamWalker::WriteUInt16(uint16_t) { throw std::runtime_error { "Unable to write into stream" }; }
+    void StreamWalker::WriteInt16(int16_t)   { throw std::runtime_error { "Unable to write into stream" }; }
+    void StreamWalker::WriteUInt32(uint32_t) { throw std::runtime_error { "Unable to write into stream" }; }
+    void StreamWalker::WriteInt32(int32_t)   { throw std::runtime_error { "Unable to write into stream" }; }
+
+    uint8_t StreamWalker::ReadUInt8() const   { return ReadValue<uint8_t>(); }
+    int8_t StreamWalker::ReadInt8() const     { return ReadValue<int8_t>(); }
+    uint16_t StreamWalker::ReadUInt16() const { return ReadValue<uint16_t>(); }
+    int16_t StreamWalker::ReadInt16() const   { return ReadValue<int16_t>(); }
+    uint32_t StreamWalker::ReadUInt32() const { return ReadValue<uint32_t>(); }
+    int32_t StreamWalker::ReadInt32() const   { return ReadValue<int32_t>(); }
+
+    void StreamWalker::ReadBytes(void* destination, size_t size) const
+    {
+        RequireSpace(size);
+
+        auto output = static_cast<uint8_t*>(destination);
+        while (size > 0)
+        {
+            const size_t chunkSize = std::min(size, m_window.size());
+            std::memcpy(output, Consume(chunkSize), chunkSize);
+
+            output += chunkSize;
+            size -= chunkSize;
+        }
+    }
+
+    const uint8_t* StreamWalker::Consume(size_t size) const
+    {
+        if (!m_stream)
+            throw std::runtime_error { "Unable to read from stream. Stream is not opened" };
+
+        RequireSpace(size);
+
+        if (size > m_window.size())
+            throw std::out_of_range { fmt::format("Unable to read {} bytes at once. Window size is {} bytes", size, m_window.size()) };
+
+        if (m_offset < m_windowBegin)
+            throw std::out_of_range { fmt::format("Unable to read at {:X}. Data before {:X} is already dropped", m_offset, m_windowBegin) };
+
+        const size_t windowEnd = m_windowBegin + m_windowFill; // Equal to the stream position
+
+        if (m_offset + size > windowEnd)
+        {
+            if (m_offset >= windowEnd)
+            {
+                // Caret was moved forward by Seek: inflate and drop everything before it
+                size_t bytesToSkip = m_offset - windowEnd;
+                while (bytesToSkip > 0)
+                {
+                    const size_t skipped = m_stream->Read(m_window.data(), std::min(bytesToSkip, m_window.size()));
+                    if (!skipped)
+                        throw std::runtime_error { fmt::format("Unexpected end of stream {}", m_stream->GetPath()) };
+
+                    bytesToSkip -= skipped;
+                }
+
+                m_windowFill = 0;
+            }
+            else
+            {
+                // Keep only not consumed tail of the window
+                m_windowFill = windowEnd - m_offset;
+                std::memmove(m_window.data(), m_window.data() + (m_offset - m_windowBegin), m_windowFill);
+            }
+
+            m_windowBegin = m_offset;
+
+            while (m_windowFill < size)
+            {
+                const size_t readBytes = m_stream->Read(m_window.data() + m_windowFill, m_window.size() - m_windowFill);
+                if (!readBytes)
+                    throw std::runtime_error { fmt::format("Unexpected end of stream {}", m_stream->GetPath()) };
+
+                m_windowFill += readBytes;
+            }
+        }
+
+        const uint8_t* ptr = m_window.data() + (m_offset - m_windowBegin);
+        m_offset += size;
+        return ptr;
+    }
+}
@@ -9,9 +9,11 @@
 
 #include <spdlog/spdlog.h>
 
-#include <BinaryWalker.h>
+#include <BasicBinaryWalker.h>
 #include <BinaryWalkerADL.h>
 
+#include <Report/IReportWriter.h>
+
 #include <utility>
 #include <array>
 
@@ -29,19 +31,19 @@ namespace ReGlacier
         m_textures.clear();
 
         size_t texBufferSize = 0;
-        auto texBuffer = m_container->Read(m_name, texBufferSize);
+        auto texBuffer = m_container->ReadShared(m_name, texBufferSize);
         if (!texBuffer)
         {
             spdlog::error("TEX::Load| Failed to load TEX file {}", m_name);
             return false;
         }
 
-        BinaryWalker binaryWalker(texBuffer.get(), texBufferSize);
+        BinaryReader binaryWalker(texBuffer.get(), texBufferSize);
 
         STEXHeader header {};
         BinaryWalkerADL<STEXHeader>::Read(binaryWalker, header);
 
-        binaryWalker.Seek(header.Table1Location, BinaryWalker::SeekType::FROM_BEGIN);
+        binaryWalker.Seek(header.Table1Location, BinaryReader::BEGIN);
 
         std::array<uint32_t, kOffsetsTableSize> offsetsTable {};
         binaryWalker.ReadArray(offsetsTable);
@@ -61,7 +63,7 @@ namespace ReGlacier
                 continue;;
             }
 
-            binaryWalker.Seek(offset, BinaryWalker::SeekType::FROM_BEGIN);
+            binaryWalker.Seek(offset, BinaryReader::BEGIN);
             STEXEntry entry {};
             BinaryWalkerADL<STEXEntry>::Read(binaryWalker, entry);
 
@@ -94,27 +96,25 @@ namespace ReGlacier
         }
 
         std::array<uint32_t, kOffsetsTableSize> offsetsTable2 {};
-        binaryWalker.Seek(header.Table2Location, BinaryWalker::SeekType::FROM_BEGIN);
+        binaryWalker.Seek(header.Table2Location, BinaryReader::BEGIN);
+        binaryWalker.ReadArray(offsetsTable2);
 
         for (int i = 0; i < kOffsetsTableSize; i++)
         {
-            offsetsTable2[i] = binaryWalker.Read<uint32_t>();
-            auto position = binaryWalker.GetPosition();
-
             if (offsetsTable2[i] != 0)
             {
-                binaryWalker.Seek(offsetsTable2[i], BinaryWalker::SeekType::FROM_BEGIN);
+                binaryWalker.Seek(offsetsTable2[i], BinaryReader::BEGIN);
 
-                auto indicesCount = binaryWalker.Read<int32_t>();
-                std::vector<int32_t> indices;
-                indices.reserve(indicesCount);
-
-                // TODO: Rewrite to ReadArray
-                for (int j = 0; j < indicesCount; j++)
+                const auto indicesCount = binaryWalker.Read<int32_t>();
+                if (indicesCount <= 0 || static_cast<size_t>(indicesCount) > (binaryWalker.GetSize() - binaryWalker.GetPosition()) / sizeof(int32_t))
                 {
-                    indices.push_back(binaryWalker.Read<int32_t>());
+                    spdlog::error("TEX::Load| Bad indices count {} at {:X} in TEX {}", indicesCount, offsetsTable2[i], m_name);
+                    return false;
                 }
 
+                std::vector<int32_t> indices(indicesCount);
+                binaryWalker.ReadArray(indices);
+
                 int index = 0;
 
                 if (indices[indicesCount - 1] == 0)
@@ -131,14 +131,16 @@ namespace ReGlacier
                     index = indices[indicesCount - 1] - emptyBlocks;
                 }
 
-                assert(index >= 0 && index < m_textures.size());
+                if (index < 0 || static_cast<size_t>(index) >= m_textures.size())
+                {
+                    spdlog::error("TEX::Load| Bad texture index {} at {:X} in TEX {} (total textures {})", index, offsetsTable2[i], m_name, m_textures.size());
+                    return false;
+                }
 
                 m_textures[index]->m_indicesCount = indicesCount;
                 m_textures[index]->m_indices.reserve(indicesCount);
 
                 std::copy(std::begin(indices), std::end(indices), std::back_inserter(m_textures[index]->m_indices));
-
-                binaryWalker.Seek(position, BinaryWalker::SeekType::FROM_BEGIN);
             }
         }
 
@@ -146,6 +148,31 @@ namespace ReGlacier
         return true;
     }
 
+    void TEX::WriteReport(IReportWriter& writer)
+    {
+        writer.BeginRecord("tex");
+        writer.WriteUInt("textures", m_textures.size());
+        writer.EndRecord();
+
+        for (size_t i = 0; i < m_textures.size(); i++)
+        {
+            const auto& texture = m_textures[i];
+            if (!texture)
+            {
+                continue;
+            }
+
+            writer.BeginRecord("tex.texture");
+            writer.WriteUInt("index", i);
+            writer.WriteString("name", texture->GetName());
+            writer.WriteInt("width", texture->GetWidth());
+            writer.WriteInt("height", texture->GetHeight());
+            writer.WriteInt("mip", texture->GetMip());
+            writer.WriteUInt("type", static_cast<uint32_t>(texture->GetEntityType()));
+            writer.EndRecord();
+        }
+    }
+
     const std::vector<Texture::Ptr> & TEX::GetLoadedTextures() const
     {
         return m_textures;
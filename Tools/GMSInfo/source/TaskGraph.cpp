@@ -0,0 +1,108 @@
+#include <TaskGraph.h>
+#include <ThreadPool.h>
+
+#include <spdlog/spdlog.h>
+
+namespace ReGlacier
+{
+    TaskGraph::TaskId TaskGraph::AddTask(std::string name, Routine&& routine, std::initializer_list<TaskId> dependencies)
+    {
+        const TaskId taskId = m_tasks.size();
+
+        auto& task = m_tasks.emplace_back();
+        task.Name = std::move(name);
+        task.Body = std::move(routine);
+
+        for (const auto dependency : dependencies)
+        {
+            if (dependency >= taskId)
+                throw std::out_of_range { fmt::format("TaskGraph| Task {} depends on unknown task #{}", m_tasks[taskId].Name, dependency) };
+
+            m_tasks[dependency].Dependents.push_back(taskId);
+            ++m_tasks[taskId].PendingDependencies;
+        }
+
+        return taskId;
+    }
+
+    void TaskGraph::Run(ThreadPool& pool)
+    {
+        m_finishedTasks = 0;
+        m_firstException = nullptr;
+
+        // Collect roots before scheduling: inline pool could finish task (and change counters) inside Submit
+        std::vector<TaskId> roots;
+        for (TaskId taskId = 0; taskId < m_tasks.size(); taskId++)
+        {
+            if (m_tasks[taskId].PendingDependencies == 0)
+            {
+                roots.push_back(taskId);
+            }
+        }
+
+        for (const auto taskId : roots)
+        {
+            Schedule(pool, taskId);
+        }
+
+        std::unique_lock<std::mutex> lock { m_mutex };
+        m_allTasksFinished.wait(lock, [this]() { return m_finishedTasks == m_tasks.size(); });
+
+        if (m_firstException)
+        {
+            std::rethrow_exception(m_firstException);
+        }
+    }
+
+    void TaskGraph::Schedule(ThreadPool& pool, TaskId taskId)
+    {
+        pool.Submit([this, &pool, taskId]() {
+            try
+            {
+                m_tasks[taskId].Body();
+            }
+            catch (...)
+            {
+                spdlog::error("TaskGraph| Task {} failed with exception", m_tasks[taskId].Name);
+
+                std::lock_guard<std::mutex> lock { m_mutex };
+                if (!m_firstException)
+                {
+                    m_firstException = std::current_exception();
+                }
+            }
+
+            OnTaskFinished(pool, taskId);
+        });
+    }
+
+    void TaskGraph::OnTaskFinished(ThreadPool& pool, TaskId taskId)
+    {
+        std::vector<TaskId> readyTasks;
+
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+
+            for (const auto dependent : m_tasks[taskId].Dependents)
+            {
+                if (--m_tasks[dependent].PendingDependencies == 0)
+                {
+                    readyTasks.push_back(dependent);
+                }
+            }
+
+            ++m_finishedTasks;
+
+            if (m_finishedTasks == m_tasks.size())
+            {
+                // Notify under lock: graph could be destroyed right after Run() wakes up
+                m_allTasksFinished.notify_all();
+            }
+        }
+
+        for (const auto readyTask : readyTasks)
+        {
+            Schedule(pool, readyTask);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#include <ThreadPool.h>
+
+namespace ReGlacier
+{
+    ThreadPool::ThreadPool(size_t workersCount)
+    {
+        m_workers.reserve(workersCount);
+
+        for (size_t i = 0; i < workersCount; i++)
+        {
+            m_workers.emplace_back(&ThreadPool::WorkerRoutine, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_isStopRequested = true;
+        }
+
+        m_hasTasks.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::Submit(Task&& task)
+    {
+        if (m_workers.empty())
+        {
+            task();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_tasks.push(std::move(task));
+        }
+
+        m_hasTasks.notify_one();
+    }
+
+    size_t ThreadPool::GetWorkersCount() const
+    {
+        return m_workers.size();
+    }
+
+    size_t ThreadPool::GetDefaultWorkersCount()
+    {
+        const auto hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 0 ? hardwareThreads : 1;
+    }
+
+    void ThreadPool::WorkerRoutine()
+    {
+        while (true)
+        {
+            Task task;
+
+            {
+                std::unique_lock<std::mutex> lock { m_mutex };
+                m_hasTasks.wait(lock, [this]() { return m_isStopRequested || !m_tasks.empty(); });
+
+                if (m_tasks.empty())
+                {
+                    // Stop requested and nothing to do
+                    return;
+                }
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+
+            task();
+        }
+    }
+}
@@ -1,10 +1,40 @@
 #include <TypesDataBase.h>
+#include <GlacierTypeDefs.h>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
 #include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 namespace ReGlacier
 {
+    static constexpr uint32_t kSnapshotMagic = 0x42445447; // 'GTDB'
+    static constexpr uint32_t kSnapshotVersion = 1;
+
+    struct SnapshotHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t RecordsCount;
+        uint32_t StringsSize;
+    };
+
+    struct TypesDataBase::SnapshotRecord
+    {
+        uint32_t Id;
+        uint32_t NameOffset;       ///< Offset of zero terminated string in string pool
+        uint32_t ParentNameOffset; ///< Offset of zero terminated string in string pool
+    };
+
+    // Snapshot is mapped as is
+    static_assert(std::endian::native == std::endian::little, "Snapshot format is little endian only");
+    static_assert(sizeof(SnapshotHeader) == 0x10 && std::is_trivially_copyable_v<SnapshotHeader>);
+
     TypesDataBase* g_typesDataBase { nullptr };
 
     TypesDataBase& TypesDataBase::GetInstance()
@@ -28,8 +58,18 @@ namespace ReGlacier
 
     bool TypesDataBase::Load(const std::string& path)
     {
-        m_db.clear();
+        Clear();
+
+        if (path.ends_with(kSnapshotExtension))
+        {
+            return LoadSnapshot(path);
+        }
+
+        return LoadJson(path);
+    }
 
+    bool TypesDataBase::LoadJson(const std::string& path)
+    {
         std::ifstream fileStream(path, std::ifstream::binary);
         if (!fileStream) {
             spdlog::error("Failed to open types data base file {}", path);
@@ -38,11 +78,29 @@ namespace ReGlacier
 
         try {
             auto db = nlohmann::json::parse(fileStream);
-            nlohmann::adl_serializer<decltype(m_db)>::from_json(db, m_db);
-            spdlog::info("Type information DB loaded");
+            m_db.reserve(db.size());
+
+            for (const auto& [key, value] : db.items())
+            {
+                size_t parsedChars = 0;
+                const auto typeId = static_cast<uint32_t>(std::stoul(key, &parsedChars, 16));
+                if (parsedChars != key.size())
+                {
+                    spdlog::warn("TypesDataBase::Load| Invalid type id {} in file {}", key, path);
+                    continue;
+                }
+
+                const auto& names = value.get<std::array<std::string, 2>>();
+                m_db[typeId] = TypeInfo { Intern(names[0]), Intern(names[1]) };
+            }
+
+            spdlog::info("Type information DB loaded ({} types)", m_db.size());
         } catch (nlohmann::json::exception& ex) {
             spdlog::error("Invalid types data base file {}. Parse error: {}", path, ex.what());
             return false;
+        } catch (std::logic_error& ex) {
+            spdlog::error("Invalid types data base file {}. Bad type id: {}", path, ex.what());
+            return false;
         }
 
         fileStream.close();
@@ -50,22 +108,180 @@ namespace ReGlacier
         return true;
     }
 
+    bool TypesDataBase::LoadSnapshot(const std::string& path)
+    {
+        static_assert(sizeof(SnapshotRecord) == 0xC && std::is_trivially_copyable_v<SnapshotRecord>);
+
+        auto snapshot = std::make_shared<MappedFile>(path);
+        if (!snapshot->Open())
+        {
+            spdlog::error("Failed to open types data base snapshot {}", path);
+            return false;
+        }
+
+        SnapshotHeader header {};
+        if (snapshot->GetSize() < sizeof(header))
+        {
+            spdlog::error("Invalid types data base snapshot {}. File is too small", path);
+            return false;
+        }
+
+        std::memcpy(&header, snapshot->GetData(), sizeof(header));
+        if (header.Magic != kSnapshotMagic || header.Version != kSnapshotVersion)
+        {
+            spdlog::error("Invalid types data base snapshot {}. Bad magic or unsupported version {}", path, header.Version);
+            return false;
+        }
+
+        const size_t recordsSize = static_cast<size_t>(header.RecordsCount) * sizeof(SnapshotRecord);
+        const auto records = snapshot->GetRange(sizeof(header), recordsSize);
+        const auto strings = snapshot->GetRange(sizeof(header) + recordsSize, header.StringsSize);
+
+        // Every string offset must point into the pool and the pool must end by terminator, so any view is bounded
+        if ((recordsSize && records.empty()) || strings.empty() || strings.back() != 0)
+        {
+            spdlog::error("Invalid types data base snapshot {}. File is truncated", path);
+            return false;
+        }
+
+        const auto* snapshotRecords = reinterpret_cast<const SnapshotRecord*>(records.data());
+        for (size_t i = 0; i < header.RecordsCount; i++)
+        {
+            const auto& record = snapshotRecords[i];
+            const bool isSorted = i == 0 || snapshotRecords[i - 1].Id < record.Id;
+
+            if (!isSorted || record.NameOffset >= header.StringsSize || record.ParentNameOffset >= header.StringsSize)
+            {
+                spdlog::error("Invalid types data base snapshot {}. Broken record #{}", path, i);
+                return false;
+            }
+        }
+
+        m_snapshot = std::move(snapshot);
+        m_snapshotRecords = snapshotRecords;
+        m_snapshotRecordsCount = header.RecordsCount;
+        m_snapshotStrings = reinterpret_cast<const char*>(strings.data());
+
+        spdlog::info("Type information DB snapshot loaded ({} types)", m_snapshotRecordsCount);
+        return true;
+    }
+
+    bool TypesDataBase::SaveSnapshot(const std::string& path) const
+    {
+        std::vector<SnapshotRecord> records;
+        std::string strings;
+        std::unordered_map<std::string_view, uint32_t> stringOffsets;
+
+        auto addString = [&strings, &stringOffsets](std::string_view value) -> uint32_t {
+            auto [it, isInserted] = stringOffsets.try_emplace(value, static_cast<uint32_t>(strings.size()));
+            if (isInserted)
+            {
+                strings.append(value);
+                strings.push_back('\0');
+            }
+            return it->second;
+        };
+
+        auto addType = [&records, &addString](uint32_t id, const TypeInfo& type) {
+            records.push_back(SnapshotRecord { id, addString(type.Name), addString(type.ParentName) });
+        };
+
+        for (size_t i = 0; i < m_snapshotRecordsCount; i++)
+        {
+            const auto& record = m_snapshotRecords[i];
+            if (!m_db.contains(record.Id))
+            {
+                addType(record.Id, TypeInfo { m_snapshotStrings + record.NameOffset, m_snapshotStrings + record.ParentNameOffset });
+            }
+        }
+
+        for (const auto& [id, type] : m_db)
+        {
+            addType(id, type);
+        }
+
+        std::sort(std::begin(records), std::end(records), [](const SnapshotRecord& lhs, const SnapshotRecord& rhs) { return lhs.Id < rhs.Id; });
+
+        if (strings.empty())
+        {
+            strings.push_back('\0');
+        }
+
+        const SnapshotHeader header { kSnapshotMagic, kSnapshotVersion, static_cast<uint32_t>(records.size()), static_cast<uint32_t>(strings.size()) };
+
+        std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(SnapshotRecord)));
+        stream.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+        if (!stream)
+        {
+            spdlog::error("Failed to write types data base snapshot {}", path);
+            return false;
+        }
+
+        spdlog::info("Types data base snapshot with {} types saved to {}", records.size(), path);
+        return true;
+    }
+
+    std::optional<TypesDataBase::TypeInfo> TypesDataBase::FindType(uint32_t entityTypeId) const
+    {
+        if (!m_db.empty())
+        {
+            if (auto iter = m_db.find(entityTypeId); iter != std::end(m_db))
+            {
+                return iter->second;
+            }
+        }
+
+        if (m_snapshotRecordsCount)
+        {
+            const auto* end = m_snapshotRecords + m_snapshotRecordsCount;
+            const auto* record = std::lower_bound(m_snapshotRecords, end, entityTypeId, [](const SnapshotRecord& lhs, uint32_t id) { return lhs.Id < id; });
+
+            if (record != end && record->Id == entityTypeId)
+            {
+                return TypeInfo { m_snapshotStrings + record->NameOffset, m_snapshotStrings + record->ParentNameOffset };
+            }
+        }
+
+        if (const auto* builtinType = Glacier::FindBuiltinType(entityTypeId))
+        {
+            return TypeInfo { builtinType->Name, builtinType->ParentName };
+        }
+
+        return std::nullopt;
+    }
+
     bool TypesDataBase::HasDefinitionForEntityTypeId(unsigned int entityTypeId) const
     {
-        std::string value = fmt::format("0x{:X}", entityTypeId);
-        auto iter = m_db.find(value);
-        return iter != std::end(m_db);
+        return FindType(entityTypeId).has_value();
     }
 
     std::string TypesDataBase::GetEntityTypeById(unsigned int entityTypeId) const
     {
-        std::string value = fmt::format("0x{:X}", entityTypeId);
-        auto iter = m_db.find(value);
-        if (iter != std::end(m_db))
+        if (const auto type = FindType(entityTypeId))
         {
-            return fmt::format("{} : {} (0x{:X})", iter->second[0], iter->second[1], entityTypeId);
+            return fmt::format("{} : {} (0x{:X})", type->Name, type->ParentName, entityTypeId);
         }
 
         return fmt::format("NOT FOUND 0x{:X}", entityTypeId);
     }
-}
\ No newline at end of file
+
+    void TypesDataBase::Clear()
+    {
+        m_db.clear();
+        m_names.clear();
+
+        m_snapshotRecords = nullptr;
+        m_snapshotRecordsCount = 0;
+        m_snapshotStrings = nullptr;
+        m_snapshot = nullptr;
+    }
+
+    std::string_view TypesDataBase::Intern(const std::string& name)
+    {
+        // Nodes of unordered_set are stable, so views stay valid until the set is cleared
+        return *m_names.insert(name).first;
+    }
+}
@@ -0,0 +1,81 @@
+#include <ZPackedDecoder.h>
+#include <InflateBackend.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ReGlacier
+{
+    bool ZPackedDecoder::ReadHeader(const uint8_t* packed, size_t packedSize, Header& header)
+    {
+        if (!packed || packedSize < kHeaderSize)
+        {
+            spdlog::error("ZPackedDecoder| Buffer is too small ({} bytes)", packedSize);
+            return false;
+        }
+
+        std::memcpy(&header.UncompressedSize, packed, sizeof(uint32_t));
+        std::memcpy(&header.CompressedSize, packed + 4, sizeof(uint32_t));
+        header.IsStored = packed[8] != 0;
+
+        return true;
+    }
+
+    size_t ZPackedDecoder::GetUnpackedBufferSize(const Header& header)
+    {
+        return (static_cast<size_t>(header.UncompressedSize) + kOutputAlignment - 1) & ~(kOutputAlignment - 1);
+    }
+
+    bool ZPackedDecoder::UnpackInto(const uint8_t* packed, size_t packedSize, const Header& header, uint8_t* output, size_t outputSize)
+    {
+        if (!packed || packedSize < kHeaderSize)
+        {
+            spdlog::error("ZPackedDecoder| Buffer is too small ({} bytes)", packedSize);
+            return false;
+        }
+
+        if (outputSize < header.UncompressedSize)
+        {
+            spdlog::error("ZPackedDecoder| Output buffer is too small ({} bytes, required {})", outputSize, header.UncompressedSize);
+            return false;
+        }
+
+        // Output is not initialized by allocators, so zero the alignment padding only (contents are overwritten below)
+        std::memset(output + header.UncompressedSize, 0, outputSize - header.UncompressedSize);
+
+        const uint8_t* data = packed + kHeaderSize;
+        const size_t dataSize = packedSize - kHeaderSize;
+
+        if (header.IsStored)
+        {
+            const size_t length = std::min({ static_cast<size_t>(header.UncompressedSize), dataSize, outputSize });
+            std::memcpy(output, data, length);
+            return length == header.UncompressedSize;
+        }
+
+        return Inflate(data, std::min(static_cast<size_t>(header.CompressedSize), dataSize), output, header.UncompressedSize);
+    }
+
+    bool ZPackedDecoder::Inflate(const uint8_t* input, size_t inputSize, uint8_t* output, size_t uncompressedSize)
+    {
+        size_t writtenBytes = 0;
+        if (!InflateBackend::InflateRaw(input, inputSize, output, uncompressedSize, writtenBytes))
+        {
+            return false;
+        }
+
+        if (writtenBytes != uncompressedSize)
+        {
+            spdlog::error("ZPackedDecoder| Inflated {} bytes, expected {}", writtenBytes, uncompressedSize);
+            return false;
+        }
+
+        return true;
+    }
+
+    std::unique_ptr<uint8_t[]> ZPackedDecoder::Unpack(const uint8_t* packed, size_t packedSize, size_t& unpackedSize)
+    {
+        return Unpack(packed, packedSize, unpackedSize, [](size_t size) { return std::make_unique_for_overwrite<uint8_t[]>(size); });
+    }
+}
@@ -2,20 +2,31 @@
  GMS Tool for Hitman Blood Money
  **/
 #include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
 
 #include <spdlog/spdlog.h>
 
+#include <Common/Logging.h>
+
 #include <TypesDataBase.h>
 #include <LevelDescription.h>
+#include <ThreadPool.h>
+#include <TaskGraph.h>
+#include <Report/ReportWriterFactory.h>
 
 // CLI11
 #include <CLI/App.hpp>
 #include <CLI/Formatter.hpp>
 #include <CLI/Config.hpp>
 
-static constexpr const char* kDefaultTypeStorageFile = "typeids.json";
+static constexpr const char* kDefaultReportsDirectory = "reports";
+static constexpr const char* kSummaryReportFile = "summary.txt";
+static constexpr const char* kDefaultParseTraceFile = "parse_trace.log";
 
-int main(int argc, char** argv)
+struct ToolOptions
 {
     bool printLevelInfo { false };
     bool ignoreGMS { false };
@@ -27,89 +38,448 @@ int main(int argc, char** argv)
     bool ignoreSND { false };
 
     std::string levelArchivePath;
-    std::string typesDataBaseFilePath = kDefaultTypeStorageFile;
+    std::string levelsDirectoryPath;
+    std::string reportsDirectoryPath = kDefaultReportsDirectory;
+    size_t jobs { ReGlacier::ThreadPool::GetDefaultWorkersCount() };
+    std::string typesDataBaseFilePath;
+    std::string typesSnapshotPath;
     std::string uncompressedGMSPath;
     std::string exportLocalizationToFilePath;
     std::string generateUncompressedGMSPath;
+    std::string extractAllDirectoryPath;
+    std::string extractAssetsDirectoryPath;
+    std::string parseDiagnosticsLevel = "off";
+    std::string parseTraceFilePath = kDefaultParseTraceFile;
+    std::string reportFormatName = "text";
+    std::string reportFilePath;
+    std::vector<std::string> geomQueries;
+    ReGlacier::ReportFormat reportFormat { ReGlacier::ReportFormat::Text };
+    ReGlacier::ParseDiagnostics parseDiagnostics {};
+    ReHitmanTools::LoggingOptions logging {};
+};
 
-    CLI::App app { "GMS Tool" };
+struct LevelSummary
+{
+    std::string levelArchivePath;
+    bool isOpened { false };
+    bool isLoaded { false };
+    std::chrono::milliseconds duration { 0 };
+};
 
-    app.add_option("--level", levelArchivePath, "Path to level ZIP")->required();
-    app.add_option("--types", typesDataBaseFilePath, "Set types DB JSON file");
-    app.add_option("--export-gms", uncompressedGMSPath, "Export uncompressed GMS to specified file");
-    app.add_option("--print-info", printLevelInfo, "Dump level info to console");
-    app.add_option("--export-loc", exportLocalizationToFilePath, "Export decompiled LOC file into file at specified path");
-    app.add_option("--ignore-gms", ignoreGMS, "Ignore .GMS file");
-    app.add_option("--ignore-anm", ignoreANM, "Ignore .ANM file");
-    app.add_option("--ignore-loc", ignoreLOC, "Ignore .LOC file");
-    app.add_option("--ignore-prm", ignorePRM, "Ignore .PRM file");
-    app.add_option("--ignore-prp", ignorePRP, "Ignore .PRP file");
-    app.add_option("--ignore-tex", ignoreTEX, "Ignore .TEX file");
-    app.add_option("--ignore-snd", ignoreSND, "Ignore .SND file");
-    app.add_option("--generate-uncompressed-gms", generateUncompressedGMSPath, "Generate GMS with uncompressed body");
-    CLI11_PARSE(app, argc, argv);
+static void SetupLevelOptions(ReGlacier::LevelDescription& level, const ToolOptions& options)
+{
+    level.SetIgnoreGMSFlag(options.ignoreGMS);
+    level.SetIgnoreANMFlag(options.ignoreANM);
+    level.SetIgnoreLOCFlag(options.ignoreLOC);
+    level.SetIgnorePRMFlag(options.ignorePRM);
+    level.SetIgnorePRPFlag(options.ignorePRP);
+    level.SetIgnoreTEXFlag(options.ignoreTEX);
+    level.SetIgnoreSNDFlag(options.ignoreSND);
+    level.SetParseDiagnostics(options.parseDiagnostics);
+}
 
-    if (!ReGlacier::TypesDataBase::GetInstance().Load(typesDataBaseFilePath))
+static bool WriteLevelReport(ReGlacier::LevelDescription& level, bool isLoaded, const std::string& path, ReGlacier::ReportFormat format)
+{
+    if (format == ReGlacier::ReportFormat::Text)
     {
-        spdlog::error("Failed to load types database from file {}", typesDataBaseFilePath);
-        return -2;
+        // Written by logger thread
+        auto report = ReHitmanTools::LoggingSession::CreateFileLogger(std::filesystem::path(path).filename().string(), path);
+        if (!report)
+        {
+            return false;
+        }
+
+        level.PrintInfo(*report);
+        return true;
+    }
+
+    // Structured report is written in one pass through own buffer, no logger involved
+    auto writer = ReGlacier::ReportWriterFactory::Create(format, path);
+    if (!writer)
+    {
+        return false;
+    }
+
+    level.WriteReport(*writer, isLoaded);
+    return writer->Flush();
+}
+
+/**
+ * @brief Print geoms matched by query: type:<type name or id>, prefix:<geom name prefix>, prm:<PRM offset>
+ */
+static bool RunGeomQuery(const ReGlacier::LevelDescription& level, std::string_view query)
+{
+    const auto separator = query.find(':');
+    if (separator == std::string_view::npos)
+    {
+        spdlog::error("Bad geoms query '{}'. Use type:<name or id>, prefix:<name prefix> or prm:<offset>", query);
+        return false;
     }
 
+    const auto kind = query.substr(0, separator);
+    const auto value = query.substr(separator + 1);
+
+    const auto parseNumber = [](std::string_view text, uint32_t& number) -> bool {
+        try
+        {
+            size_t parsed = 0;
+            number = static_cast<uint32_t>(std::stoul(std::string(text), &parsed, 0));
+            return parsed == text.size();
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    };
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<uint32_t> geoms;
+    uint32_t number = 0;
+
+    if (kind == "type")
+    {
+        if (parseNumber(value, number))
+        {
+            const auto found = level.FindGeomsByType(number);
+            geoms.assign(found.begin(), found.end());
+        }
+        else
+        {
+            geoms = level.FindGeomsByTypeName(value);
+        }
+    }
+    else if (kind == "prefix")
+    {
+        const auto found = level.FindGeomsByNamePrefix(value);
+        geoms.assign(found.begin(), found.end());
+    }
+    else if (kind == "prm" && parseNumber(value, number))
+    {
+        const auto found = level.FindGeomsByPRMOffset(number);
+        geoms.assign(found.begin(), found.end());
+    }
+    else
+    {
+        spdlog::error("Bad geoms query '{}'. Use type:<name or id>, prefix:<name prefix> or prm:<offset>", query);
+        return false;
+    }
+
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    spdlog::info("Query '{}': {} geoms ({} us)", query, geoms.size(), duration.count());
+    spdlog::info("    ID   |            Entity Name            |  Type ID  | PRM offset");
+    for (const auto geomIndex : geoms)
+    {
+        if (const auto geom = level.GetGeomInfo(geomIndex))
+        {
+            spdlog::info("{:08X} {:33} {:8X}   {:8X}", geom->Index, geom->Name, geom->TypeId, geom->PRMOffset);
+        }
+    }
+
+    return true;
+}
+
+static int RunSingleLevel(const ToolOptions& options)
+{
     // Open level archive
-    auto level = std::make_unique<ReGlacier::LevelDescription>(levelArchivePath);
+    auto level = std::make_unique<ReGlacier::LevelDescription>(options.levelArchivePath);
     if (!level->Open())
     {
-        spdlog::error("Failed to open level {}", levelArchivePath);
+        spdlog::error("Failed to open level {}", options.levelArchivePath);
         return -1;
     }
 
+    if (!options.extractAllDirectoryPath.empty())
+    {
+        // Pure unpacking, no analysis required
+        return level->ExtractAllFiles(options.extractAllDirectoryPath) ? 0 : -1;
+    }
+
+    if (!options.extractAssetsDirectoryPath.empty())
+    {
+        level->SetWorkersCount(options.jobs);
+        return level->ExtractAssets(options.extractAssetsDirectoryPath) ? 0 : -1;
+    }
+
+    SetupLevelOptions(*level, options);
+
+    bool isLoaded = false;
+
+    try
+    {
+        isLoaded = level->LoadAndAnalyze();
+    }
+    catch (const std::exception& exception)
     {
-        // Setup ignore flags
-        level->SetIgnoreGMSFlag(ignoreGMS);
-        level->SetIgnoreANMFlag(ignoreANM);
-        level->SetIgnoreLOCFlag(ignoreLOC);
-        level->SetIgnorePRMFlag(ignorePRM);
-        level->SetIgnorePRPFlag(ignorePRP);
-        level->SetIgnoreTEXFlag(ignoreTEX);
-        level->SetIgnoreSNDFlag(ignoreSND);
+        spdlog::error("Failed to analyze level {}. Reason: {}", options.levelArchivePath, exception.what());
+        return -1;
     }
 
+    if (options.printLevelInfo)
+        level->PrintInfo(*spdlog::default_logger());
 
-    level->LoadAndAnalyze();
+    if (!options.reportFilePath.empty() && !WriteLevelReport(*level, isLoaded, options.reportFilePath, options.reportFormat))
+    {
+        spdlog::error("Failed to write report {}", options.reportFilePath);
+    }
 
-    if (printLevelInfo)
-        level->PrintInfo();
+    for (const auto& query : options.geomQueries)
+    {
+        RunGeomQuery(*level, query);
+    }
 
-    if (!uncompressedGMSPath.empty())
+    if (!options.uncompressedGMSPath.empty())
     {
-        level->ExportUncompressedGMS(uncompressedGMSPath);
+        level->ExportUncompressedGMS(options.uncompressedGMSPath);
     }
 
-    if (!exportLocalizationToFilePath.empty())
+    if (!options.exportLocalizationToFilePath.empty())
     {
-        if (ignoreLOC)
+        if (options.ignoreLOC)
         {
             spdlog::warn("--export-loc option was ignored because LOC file was excluded from analysis by user");
         }
         else
         {
-            if (level->ExportLocalizationToJson(exportLocalizationToFilePath))
+            if (level->ExportLocalizationToJson(options.exportLocalizationToFilePath))
             {
-                spdlog::info("Localization exported to file {}", exportLocalizationToFilePath);
+                spdlog::info("Localization exported to file {}", options.exportLocalizationToFilePath);
             } else {
                 spdlog::error("Failed to export localization contents. More details in log.");
             }
         }
     }
 
-    if (!generateUncompressedGMSPath.empty())
+    if (!options.generateUncompressedGMSPath.empty())
     {
-        if (!level->GenerateGMSWithUncompressedBody(generateUncompressedGMSPath)) {
+        if (!level->GenerateGMSWithUncompressedBody(options.generateUncompressedGMSPath)) {
             spdlog::error("Failed to generate uncompressed GMS. See logs for defails");
         } else {
-            spdlog::info("Uncompressed GMS was saved into file {}", generateUncompressedGMSPath);
+            spdlog::info("Uncompressed GMS was saved into file {}", options.generateUncompressedGMSPath);
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+static LevelSummary AnalyzeLevelInBatch(const std::filesystem::path& levelArchivePath, const ToolOptions& options)
+{
+    LevelSummary summary;
+    summary.levelArchivePath = levelArchivePath.string();
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    ReGlacier::LevelDescription level { summary.levelArchivePath };
+    summary.isOpened = level.Open();
+
+    if (summary.isOpened)
+    {
+        SetupLevelOptions(level, options);
+        level.SetWorkersCount(1); // Levels are processed in parallel, so each level is loaded on the own worker
+
+        try
+        {
+            summary.isLoaded = level.LoadAndAnalyze();
+        }
+        catch (const std::exception& exception)
+        {
+            spdlog::error("Failed to analyze level {}. Reason: {}", summary.levelArchivePath, exception.what());
+            summary.isLoaded = false;
+        }
+
+        const auto reportPath = std::filesystem::path(options.reportsDirectoryPath) / levelArchivePath.filename().replace_extension(ReGlacier::ReportWriterFactory::GetFileExtension(options.reportFormat));
+        if (!WriteLevelReport(level, summary.isLoaded, reportPath.string(), options.reportFormat))
+        {
+            spdlog::error("Failed to write report {}", reportPath.string());
+        }
+    }
+    else
+    {
+        spdlog::error("Failed to open level {}", summary.levelArchivePath);
+    }
+
+    summary.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+    return summary;
+}
+
+static int RunBatch(const ToolOptions& options)
+{
+    std::error_code errorCode;
+
+    std::vector<std::filesystem::path> levels;
+    for (const auto& entry : std::filesystem::directory_iterator(options.levelsDirectoryPath, errorCode))
+    {
+        std::string extension = entry.path().extension().string();
+        std::for_each(std::begin(extension), std::end(extension), [](char& c) { c = static_cast<char>(std::tolower(c)); });
+
+        if (entry.is_regular_file() && extension == ".zip")
+        {
+            levels.push_back(entry.path());
+        }
+    }
+
+    if (errorCode)
+    {
+        spdlog::error("Failed to list levels directory {}: {}", options.levelsDirectoryPath, errorCode.message());
+        return -3;
+    }
+
+    std::sort(std::begin(levels), std::end(levels));
+
+    if (!std::filesystem::create_directories(options.reportsDirectoryPath, errorCode) && errorCode)
+    {
+        spdlog::error("Failed to create reports directory {}: {}", options.reportsDirectoryPath, errorCode.message());
+        return -3;
+    }
+
+    spdlog::info("Batch| Found {} levels in {}, jobs: {}", levels.size(), options.levelsDirectoryPath, options.jobs);
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<LevelSummary> summaries(levels.size());
+    {
+        ReGlacier::TaskGraph graph;
+
+        for (size_t i = 0; i < levels.size(); i++)
+        {
+            graph.AddTask(levels[i].filename().string(), [&summaries, &levels, &options, i]() {
+                summaries[i] = AnalyzeLevelInBatch(levels[i], options);
+            });
+        }
+
+        ReGlacier::ThreadPool pool { options.jobs > 1 ? options.jobs : 0 };
+        graph.Run(pool);
+    }
+
+    const auto totalDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+    // Aggregated summary (file + sinks of default logger). Same logger thread keeps it after messages of levels
+    const auto summaryPath = std::filesystem::path(options.reportsDirectoryPath) / kSummaryReportFile;
+    auto summaryLogger = ReHitmanTools::LoggingSession::CreateFileLogger("summary", summaryPath.string());
+    if (!summaryLogger)
+    {
+        return -3;
+    }
+
+    auto& summaryReport = *summaryLogger;
+    for (const auto& sink : spdlog::default_logger()->sinks())
+    {
+        summaryReport.sinks().push_back(sink);
+    }
+
+    size_t failedLevels = 0;
+
+    summaryReport.info("Batch summary:");
+    summaryReport.info("  Status  |  Time (ms)  | Level");
+    for (const auto& summary : summaries)
+    {
+        const char* status = !summary.isOpened ? "NOT OPEN" : (summary.isLoaded ? "OK" : "FAILED");
+        if (!summary.isOpened || !summary.isLoaded)
+        {
+            ++failedLevels;
+        }
+
+        summaryReport.info(" {:8} | {:11} | {}", status, summary.duration.count(), summary.levelArchivePath);
+    }
+    summaryReport.info("Total levels: {}, succeeded: {}, failed: {}, total time: {} ms", summaries.size(), summaries.size() - failedLevels, failedLevels, totalDuration.count());
+
+    return failedLevels == 0 ? 0 : -1;
+}
+
+int main(int argc, char** argv)
+{
+    ToolOptions options;
+
+    CLI::App app { "GMS Tool" };
+
+    auto levelOption = app.add_option("--level", options.levelArchivePath, "Path to level ZIP");
+    auto levelsDirOption = app.add_option("--levels-dir", options.levelsDirectoryPath, "Analyze all level ZIPs from directory (batch mode)");
+    levelOption->excludes(levelsDirOption);
+    app.add_option("--jobs", options.jobs, "Total levels analyzed in parallel in batch mode (or assets extracted in parallel with --extract-assets)");
+    app.add_option("--reports-dir", options.reportsDirectoryPath, "Directory for level reports in batch mode");
+    app.add_option("--report-format", options.reportFormatName, "Format of level reports: text (default), ndjson (JSON object per line), binary");
+    auto reportOption = app.add_option("--report", options.reportFilePath, "Write level report into file (format is set by --report-format)");
+    auto findGeomsOption = app.add_option("--find-geoms", options.geomQueries, "Print geoms matched by query: type:<type name or id>, prefix:<geom name prefix>, prm:<PRM offset> (option could be repeated)");
+    auto typesOption = app.add_option("--types", options.typesDataBaseFilePath, "Load additional types from JSON file or binary snapshot *.bin (types from data/typeids.json are built in)");
+    app.add_option("--save-types-snapshot", options.typesSnapshotPath, "Convert types file from --types option into binary snapshot and exit")->needs(typesOption);
+    auto exportGMSOption = app.add_option("--export-gms", options.uncompressedGMSPath, "Export uncompressed GMS to specified file");
+    app.add_option("--print-info", options.printLevelInfo, "Dump level info to console");
+    auto exportLOCOption = app.add_option("--export-loc", options.exportLocalizationToFilePath, "Export decompiled LOC file into file at specified path");
+    app.add_option("--ignore-gms", options.ignoreGMS, "Ignore .GMS file");
+    app.add_option("--ignore-anm", options.ignoreANM, "Ignore .ANM file");
+    app.add_option("--ignore-loc", options.ignoreLOC, "Ignore .LOC file");
+    app.add_option("--ignore-prm", options.ignorePRM, "Ignore .PRM file");
+    app.add_option("--ignore-prp", options.ignorePRP, "Ignore .PRP file");
+    app.add_option("--ignore-tex", options.ignoreTEX, "Ignore .TEX file");
+    app.add_option("--ignore-snd", options.ignoreSND, "Ignore .SND file");
+    app.add_option("--parse-diagnostics", options.parseDiagnosticsLevel, "Diagnostics of asset parsers: off (default), summary (counters in report), trace (line per parsed element)");
+    app.add_option("--parse-trace-file", options.parseTraceFilePath, "File for trace lines of --parse-diagnostics trace");
+    auto generateGMSOption = app.add_option("--generate-uncompressed-gms", options.generateUncompressedGMSPath, "Generate GMS with uncompressed body");
+    auto extractAllOption = app.add_option("--extract-all", options.extractAllDirectoryPath, "Unpack all files of the level archive into specified directory (without analysis)");
+    auto extractAssetsOption = app.add_option("--extract-assets", options.extractAssetsDirectoryPath, "Unpack known level assets into specified directory in parallel (--jobs threads, without analysis)");
+    extractAllOption->excludes(extractAssetsOption);
+
+    // Export options are single file outputs, they have no sense in batch mode
+    levelsDirOption->excludes(reportOption)->excludes(findGeomsOption)->excludes(exportGMSOption)->excludes(exportLOCOption)->excludes(generateGMSOption)->excludes(extractAllOption)->excludes(extractAssetsOption);
+
+    ReHitmanTools::AddLoggingOptions(app, options.logging);
+
+    CLI11_PARSE(app, argc, argv);
+
+    ReHitmanTools::LoggingSession logging;
+    if (!logging.Start(options.logging))
+    {
+        return -3;
+    }
+
+    if (const auto level = ReGlacier::ParseDiagnostics::LevelFromString(options.parseDiagnosticsLevel))
+    {
+        options.parseDiagnostics.Level = level.value();
+    }
+    else
+    {
+        spdlog::error("Unknown parse diagnostics level {}. Use off, summary or trace", options.parseDiagnosticsLevel);
+        return -3;
+    }
+
+    if (const auto format = ReGlacier::ReportWriterFactory::FormatFromString(options.reportFormatName))
+    {
+        options.reportFormat = format.value();
+    }
+    else
+    {
+        spdlog::error("Unknown report format {}. Use text, ndjson or binary", options.reportFormatName);
+        return -3;
+    }
+
+    if (options.parseDiagnostics.Level == ReGlacier::ParseDiagnosticsLevel::Trace)
+    {
+        options.parseDiagnostics.TraceLogger = ReGlacier::ParseDiagnostics::CreateTraceLogger(options.parseTraceFilePath);
+        if (!options.parseDiagnostics.TraceLogger)
+        {
+            return -3;
+        }
+    }
+
+    if (!options.typesSnapshotPath.empty())
+    {
+        auto& typesDataBase = ReGlacier::TypesDataBase::GetInstance();
+        return typesDataBase.Load(options.typesDataBaseFilePath) && typesDataBase.SaveSnapshot(options.typesSnapshotPath) ? 0 : -2;
+    }
+
+    if (options.levelArchivePath.empty() && options.levelsDirectoryPath.empty())
+    {
+        spdlog::error("Level is not specified. Use --level or --levels-dir option");
+        return -3;
+    }
+
+    // Types database is shared between all levels
+    if (!options.typesDataBaseFilePath.empty() && !ReGlacier::TypesDataBase::GetInstance().Load(options.typesDataBaseFilePath))
+    {
+        spdlog::error("Failed to load types database from file {}", options.typesDataBaseFilePath);
+        return -2;
+    }
+
+    return !options.levelsDirectoryPath.empty() ? RunBatch(options) : RunSingleLevel(options);
+}
@@ -7,14 +7,16 @@
 """
 import sys
 import json
-import datetime
+import random
+import hashlib
 
 
 class TypeRow:
-    def __init__(self, index, name, parent=None):
+    def __init__(self, index, name, parent=None, original_name=None):
         self._index = index
         self._name = name
         self._parent = parent
+        self._original_name = original_name if original_name else name
 
     @property
     def PrettyName(self):
@@ -39,13 +41,90 @@ class TypeRow:
     def ParentClassName(self):
         return self._parent
 
-def generate_map_between_typeid_and_name(class_list):
-    defs = []
-    for cl in  class_list:
-        defs.append("\t\t\t{{ Glacier::TypeId::{}, \"{}\" }}".format(cl.PrettyName, cl.PrettyName))
-    return ',\n'.join(defs)
+    @property
+    def OriginalClassName(self):
+        return self._original_name
+
+def find_perfect_hash(type_ids):
+    """
+        Search multiplier for hash (id * multiplier) >> (32 - bits) without collisions on the passed ids.
+        Table has at least 2x more slots than ids, so multiplier is found in a few attempts.
+    """
+    bits = max(1, (len(type_ids) * 2 - 1).bit_length())
+    generator = random.Random(0x47414D45)  # fixed seed: same input gives same header
+
+    while True:
+        for _ in range(100000):
+            multiplier = generator.getrandbits(32) | 1
+            slots = set((type_id * multiplier & 0xFFFFFFFF) >> (32 - bits) for type_id in type_ids)
+            if len(slots) == len(type_ids):
+                return multiplier, bits
+        bits += 1
+
+
+def generate_builtin_types_table(class_list):
+    multiplier, bits = find_perfect_hash([cl.Index for cl in class_list])
+
+    table = [0] * (1 << bits)
+    for index, cl in enumerate(class_list):
+        table[(cl.Index * multiplier & 0xFFFFFFFF) >> (32 - bits)] = index + 1
+
+    rows = ",\n".join("\t\t{{ 0x{:X}, \"{}\", \"{}\", \"{}\" }}".format(cl.Index, cl.OriginalClassName, cl.ParentClassName, cl.PrettyName) for cl in class_list)
+    slots = ",\n".join("\t\t" + ", ".join(str(slot) for slot in table[offset:offset + 16]) for offset in range(0, len(table), 16))
+
+    lines = [
+        "\t/**",
+        "\t * @struct BuiltinTypeInfo",
+        "\t * @brief Type definition from the types database which was available at build time",
+        "\t **/",
+        "\tstruct BuiltinTypeInfo {",
+        "\t\tunsigned int Id;",
+        "\t\tstd::string_view Name;",
+        "\t\tstd::string_view ParentName;",
+        "\t\tstd::string_view PrettyName;",
+        "\t};",
+        "",
+        "\tinline constexpr std::array<BuiltinTypeInfo, {}> kBuiltinTypes = {{{{".format(len(class_list)),
+        rows,
+        "\t}};",
+        "",
+        "\t// Perfect hash of kBuiltinTypes: slot = (id * multiplier) >> (32 - bits), value is index in kBuiltinTypes + 1 (0 - empty slot)",
+        "\tinline constexpr std::uint32_t kBuiltinTypesHashMultiplier = 0x{:08X}u;".format(multiplier),
+        "\tinline constexpr std::uint32_t kBuiltinTypesHashBits = {};".format(bits),
+        "\tinline constexpr std::array<std::uint16_t, {}> kBuiltinTypesHashTable = {{{{".format(len(table)),
+        slots,
+        "\t}};",
+        "",
+        "\t/**",
+        "\t * @fn FindBuiltinType",
+        "\t * @brief Find type definition by id without any allocation",
+        "\t * @param id type id",
+        "\t * @return pointer to the definition or nullptr if type is unknown",
+        "\t **/",
+        "\tconstexpr const BuiltinTypeInfo* FindBuiltinType(unsigned int id) {",
+        "\t\tconst std::uint32_t slot = static_cast<std::uint32_t>(static_cast<std::uint32_t>(id) * kBuiltinTypesHashMultiplier) >> (32 - kBuiltinTypesHashBits);",
+        "\t\tconst std::uint16_t index = kBuiltinTypesHashTable[slot];",
+        "\t\treturn (index && kBuiltinTypes[index - 1].Id == id) ? &kBuiltinTypes[index - 1] : nullptr;",
+        "\t}",
+        "",
+        "\tstatic_assert([]() {",
+        "\t\tfor (const auto& type : kBuiltinTypes) {",
+        "\t\t\tif (FindBuiltinType(type.Id) != &type) return false;",
+        "\t\t}",
+        "\t\treturn true;",
+        "\t}(), \"Perfect hash of builtin types is broken. Regenerate this file\");",
+        "",
+        ""
+    ]
+
+    return "\n".join(lines)
+
 
 def generate_definitions(input_definitions_file, output_cpp_header_file):
+    # Hash of the input instead of generation time: same input gives byte identical header
+    with open(input_definitions_file, "rb") as source_definitions_file_handler:
+        input_hash = hashlib.sha1(source_definitions_file_handler.read()).hexdigest()
+
     with open(input_definitions_file, "r") as source_definitions_file_handler:
         type_info_file_json = json.load(source_definitions_file_handler)
 
@@ -62,10 +141,12 @@ def generate_definitions(input_definitions_file, output_cpp_header_file):
                     for copy_index in range(1, 100):
                         if not "{}_{}".format(type_info_file_json[type_id][0], copy_index) in used_keys_set:
                             new_name = "{}_{}".format(type_info_file_json[type_id][0], copy_index)
-                            class_list.append(TypeRow(type_id, new_name, type_info_file_json[type_id][1]))
+                            class_list.append(TypeRow(type_id, new_name, type_info_file_json[type_id][1], type_info_file_json[type_id][0]))
                             used_keys_set.add(new_name)
                             break
 
+            known_types = list(class_list)
+
             # Add not initialised type id of default initialisation in C++ code
             class_list.append(TypeRow("std::numeric_limits<unsigned int>::max()-1", "NOT_FOUND"))
             class_list.append(TypeRow("std::numeric_limits<unsigned int>::max()", "NOT_INITIALISED"))
@@ -73,13 +154,14 @@ def generate_definitions(input_definitions_file, output_cpp_header_file):
             cpp_header_output_file.write("/*\n")
             cpp_header_output_file.write("   THIS IS AUTOGENERATED FILE!\n")
             cpp_header_output_file.write("   ALL OF YOUR CHANGES WILL BE REMOVED ON NEXT COMPILATION!\n\n")
-            cpp_header_output_file.write("   Generated by decompose.py at {}\n*/\n\n".format(datetime.datetime.now()))
+            cpp_header_output_file.write("   Generated by decompose.py from input with SHA-1 {}\n*/\n\n".format(input_hash))
             cpp_header_output_file.write("#ifndef __GLACIER_TYPE_IDS_H__\n")
             cpp_header_output_file.write("#define __GLACIER_TYPE_IDS_H__\n\n")
             # Includes
+            cpp_header_output_file.write("#include <array>\n")
+            cpp_header_output_file.write("#include <cstdint>\n")
             cpp_header_output_file.write("#include <limits>\n")
-            cpp_header_output_file.write("#include <string_view>\n")
-            cpp_header_output_file.write("#include <unordered_map>\n\n")
+            cpp_header_output_file.write("#include <string_view>\n\n")
             # Namespace
             cpp_header_output_file.write("namespace Glacier {\n")
             # Generate enum
@@ -88,21 +170,22 @@ def generate_definitions(input_definitions_file, output_cpp_header_file):
             cpp_header_output_file.write(',\n'.join(map(get_type_name, class_list)))
             # Print footer
             cpp_header_output_file.write("\n\t};\n\n")
+            # Generate constexpr table of known types with perfect hash
+            cpp_header_output_file.write(generate_builtin_types_table(known_types))
             # Generate helper function GetTypeIdAsString
             # Generate documentation
             cpp_header_output_file.write("\t/**\n"
                                          "\t * @fn GetTypeIdAsString\n"
                                          "\t * @brief This function return the type name as a string by its id from the TypeId enum\n"
                                          "\t * @param id type from enum\n"
-                                         "\t * @return type name as std::string_view\n"
+                                         "\t * @return type name as std::string_view (\"NOT_FOUND\" for unknown id)\n"
                                          "\t **/\n")
             # Generate function body
-            cpp_header_output_file.write("\tstatic std::string_view GetTypeIdAsString(TypeId id) {{\n"
-                                         "\t\tstatic const std::unordered_map<TypeId, std::string_view> g_TypeIdsToStringMap = {{\n"
-                                         "{}\n" # Inject generated code here
-                                         "\t\t}};\n"
-                                         "\t\treturn g_TypeIdsToStringMap.at(id);\n"
-                                         "\t}}\n".format(generate_map_between_typeid_and_name(class_list)))
+            cpp_header_output_file.write("\tconstexpr std::string_view GetTypeIdAsString(TypeId id) {\n"
+                                         "\t\tif (id == TypeId::NOT_INITIALISED) return \"NOT_INITIALISED\";\n"
+                                         "\t\tconst BuiltinTypeInfo* type = FindBuiltinType(id);\n"
+                                         "\t\treturn type ? type->PrettyName : \"NOT_FOUND\";\n"
+                                         "\t}\n")
             # End of file
             cpp_header_output_file.write("}\n")
             cpp_header_output_file.write("#endif")
@@ -10,6 +10,9 @@
 #include <ToolExitCodes.h>
 #include <CompilerOptionsStorage.h>
 
+// --- Shared tools code
+#include <Common/Logging.h>
+
 // --- CLI11 lib
 #include <CLI/App.hpp>
 #include <CLI/Formatter.hpp>
@@ -32,8 +35,17 @@ int main(int argc, char** argv)
     app.add_option("--g,--game", LOCC::CompilerOptions.SupportMode, "Support mode")
         ->transform(CLI::CheckedTransformer(LOCC::CompilerOptionsStorage::Consts::SupportModesMap, CLI::ignore_case));
 
+    ReHitmanTools::LoggingOptions loggingOptions {};
+    ReHitmanTools::AddLoggingOptions(app, loggingOptions);
+
     CLI11_PARSE(app, argc, argv);
 
+    ReHitmanTools::LoggingSession logging;
+    if (!logging.Start(loggingOptions))
+    {
+        return -1;
+    }
+
     if (!LOCC::FIO::HasFile(LOCC::CompilerOptions.From))
     {
         spdlog::error("LOCC| Source file {} not found!", LOCC::CompilerOptions.From);